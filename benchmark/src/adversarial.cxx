@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Worst-case inputs for the parser: long packed groups, long names, names
+ * colliding in the option table, and huge argument vectors. Each family runs
+ * at growing sizes, so the scaling is visible from the output.
+ */
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    struct owned_args {
+        explicit owned_args(std::vector<std::string> args)
+             : strings(std::move(args)) {
+            for (auto& str : strings) {
+                ptrs.push_back(str.data());
+            }
+        }
+
+        std::size_t
+        size() const noexcept { return ptrs.size(); }
+
+        char**
+        data() noexcept { return ptrs.data(); }
+
+        std::vector<std::string> strings;
+        std::vector<char*> ptrs;
+    };
+
+    constexpr const std::size_t sizes[] = {1'000, 10'000, 100'000, 1'000'000};
+
+    /// The option table mirrored: libstdc++ and MSVC's tables size their buckets
+    /// deterministically, so a map built from the same keys in the same order
+    /// puts the same names in the same buckets as the parser's
+    std::vector<std::string>
+    colliding_names(const std::vector<std::string>& keys, std::size_t count) {
+        std::unordered_map<std::string, int> mirror;
+        for (const auto& key : keys) {
+            mirror.emplace(key, 0);
+        }
+        auto target = mirror.bucket(keys.front());
+
+        std::mt19937_64 rng{42};
+        std::vector<std::string> ret;
+        while (ret.size() < count) {
+            auto name = "option-" + std::to_string(rng());
+            if (mirror.bucket(name) == target && mirror.count(name) == 0) {
+                ret.push_back("--" + name);
+            }
+        }
+        return ret;
+    }
+}
+
+TEST_CASE("Long packed groups") {
+    int v = 0;
+    ic::cli_parser cli{
+           'v'_opt >>= ic::repeat{v}};
+
+    for (auto size : sizes) {
+        owned_args args({"a.out", "-" + std::string(size, 'v')});
+        BENCHMARK("-vvv... of " + std::to_string(size)) {
+            return cli(args.size(), args.data());
+        };
+    }
+}
+
+TEST_CASE("Long option names and values") {
+    std::string str;
+    ic::cli_parser cli{
+           "str"_opt >>= str};
+    cli.unknown_behavior(ic::unknown_behavior::pass_back);
+
+    for (auto size : sizes) {
+        owned_args unknown({"a.out", "--" + std::string(size, 's')});
+        BENCHMARK("unknown name of " + std::to_string(size)) {
+            return cli(unknown.size(), unknown.data());
+        };
+
+        owned_args value({"a.out", "--str=" + std::string(size, 'x')});
+        BENCHMARK("GNU-style value of " + std::to_string(size)) {
+            return cli(value.size(), value.data());
+        };
+    }
+}
+
+TEST_CASE("Names colliding in the option table") {
+    constexpr const std::size_t options = 1'000;
+    constexpr const std::size_t queries = 1'000;
+
+    // one option with a thousand aliases gives a runtime-sized table
+    static int sink{};
+    std::vector<std::string> keys{"option-0"};
+    auto builder = "option-0"_opt;
+    for (std::size_t i = 1; i < options; ++i) {
+        keys.push_back("option-" + std::to_string(i));
+        builder = std::move(builder) / keys.back();
+    }
+    ic::cli_parser cli{
+           std::move(builder) >>= sink};
+    cli.unknown_behavior(ic::unknown_behavior::pass_back);
+
+    std::vector<std::string> random{"a.out"};
+    std::mt19937_64 rng{7};
+    for (std::size_t i = 0; i < queries; ++i) {
+        random.push_back("--option-" + std::to_string(rng()));
+    }
+    auto colliding = colliding_names(keys, queries);
+    colliding.insert(colliding.begin(), "a.out");
+
+    owned_args random_args(std::move(random));
+    owned_args colliding_args(std::move(colliding));
+
+    BENCHMARK("random unknown names") {
+        return cli(random_args.size(), random_args.data());
+    };
+    BENCHMARK("unknown names sharing a bucket") {
+        return cli(colliding_args.size(), colliding_args.data());
+    };
+}
+
+TEST_CASE("Huge argument vectors") {
+    int v = 0;
+    ic::cli_parser cli{
+           'v'_opt >>= ic::repeat{v}};
+
+    for (auto size : sizes) {
+        std::vector<std::string> strs{"a.out"};
+        for (std::size_t i = 0; i < size; ++i) {
+            strs.emplace_back(i % 2 == 0 ? "-v" : "operand");
+        }
+        owned_args args(std::move(strs));
+        BENCHMARK("argv of " + std::to_string(size)) {
+            return cli(args.size(), args.data());
+        };
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for parsing 100k command lines stored as NUL-separated buffers,
+ * like the ones recorded in build logs: one by one with a buffer_parser,
+ * whose callbacks write into variables, and into columns with a
+ * batch_parser on 1, 2, 4, and all hardware threads.
+ */
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+using namespace std::literals;
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    constexpr const std::size_t lines = 100'000;
+
+    std::vector<std::string>
+    make_buffers() {
+        std::vector<std::string> ret;
+        ret.reserve(lines);
+        for (std::size_t i = 0; i < lines; ++i) {
+            auto buf = "/usr/bin/cc\0-v\0--jobs\0"s + std::to_string(i % 16) + '\0';
+            for (std::size_t j = 0; j < i % 8; ++j) {
+                buf += "--include=dir-" + std::to_string(j) + '\0';
+            }
+            buf += "-o\0out-"s + std::to_string(i) + ".o" + '\0';
+            buf += "source.c"s + '\0';
+            ret.push_back(std::move(buf));
+        }
+        return ret;
+    }
+}
+
+TEST_CASE("Parsing 100k command lines in batches") {
+    bool verbose = false;
+    int jobs = 0;
+    std::string_view output;
+    std::vector<std::string_view> includes;
+    ic::cli_parser cli{
+           'v'_opt / "verbose" >>= verbose,
+           'j'_opt / "jobs" >>= jobs,
+           'o'_opt / "output" >>= output,
+           'I'_opt / "include" >>= includes};
+    auto buffers = make_buffers();
+    std::vector<std::string_view> views(buffers.begin(), buffers.end());
+
+    std::vector<int> job_rows(lines);
+    ic::buffer_parser parse(cli);
+    BENCHMARK("buffer_parser") {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < lines; ++i) {
+            includes.clear();
+            count += parse(views[i]).size();
+            job_rows[i] = jobs;
+        }
+        return count;
+    };
+
+    ic::batch_parser batch(cli);
+    const auto& job_column = batch.add_column<int>("jobs");
+    batch.add_column<std::string_view>("output");
+    for (std::size_t threads : {1u, 2u, 4u, 0u}) {
+        batch.threads(threads);
+        BENCHMARK("batch_parser on "
+                  + (threads == 0 ? std::to_string(std::thread::hardware_concurrency()) : std::to_string(threads))
+                  + " threads") {
+            batch(views);
+            return job_column.values.size() + batch.operands().values.size();
+        };
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for parsing 1000 command lines stored as NUL-separated buffers,
+ * like the /proc/<pid>/cmdline files of the processes of a host: split into
+ * an argv array by hand, parsed in place one by one, and with a
+ * buffer_parser reusing its storage.
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    constexpr const std::size_t lines = 1000;
+
+    std::vector<std::string>
+    make_buffers() {
+        std::vector<std::string> ret;
+        ret.reserve(lines);
+        for (std::size_t i = 0; i < lines; ++i) {
+            auto buf = "/usr/bin/tool\0-v\0--jobs\0"s + std::to_string(i % 16) + '\0';
+            for (std::size_t j = 0; j < i % 8; ++j) {
+                buf += "--input=file-" + std::to_string(j) + ".txt" + '\0';
+            }
+            buf += "operand"s + '\0';
+            ret.push_back(std::move(buf));
+        }
+        return ret;
+    }
+}
+
+TEST_CASE("Parsing 1000 NUL-separated command lines") {
+    bool verbose = false;
+    int jobs = 0;
+    std::vector<std::string_view> inputs;
+    ic::cli_parser cli{
+           'v'_opt / "verbose" >>= verbose,
+           'j'_opt / "jobs" >>= jobs,
+           'i'_opt / "input" >>= inputs};
+    auto buffers = make_buffers();
+
+    BENCHMARK("split by hand") {
+        std::size_t count = 0;
+        for (auto& buf : buffers) {
+            inputs.clear();
+            std::vector<char*> argv;
+            for (std::size_t pos = 0; pos < buf.size(); pos = buf.find('\0', pos) + 1) {
+                argv.push_back(buf.data() + pos);
+            }
+            count += cli(argv.size(), argv.data()).size();
+        }
+        return count;
+    };
+
+    BENCHMARK("cli_parser in place") {
+        std::size_t count = 0;
+        for (const auto& buf : buffers) {
+            inputs.clear();
+            count += cli(std::string_view(buf)).size();
+        }
+        return count;
+    };
+
+    ic::buffer_parser parse(cli);
+    BENCHMARK("buffer_parser") {
+        std::size_t count = 0;
+        for (const auto& buf : buffers) {
+            inputs.clear();
+            count += parse(buf).size();
+        }
+        return count;
+    };
+}
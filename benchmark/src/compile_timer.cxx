@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * cli-bench-compile-timer: the compiler launcher of the compile-time
+ * benchmarks.
+ *
+ * Runs the compiler command given after its own options, and reports the
+ * wall and CPU time and the peak RSS of the compiler, the size of the
+ * object it wrote, and the number of COMDAT groups in it, one for every
+ * template instantiation or inline function emitted. If the compiler wrote
+ * a -ftime-trace file, the class and function template instantiations
+ * recorded in it are counted too. Its own options are parsed with
+ * cli_parser::forward, so the compiler command is run from argv as-is.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <fmt/format.h>
+
+#include <info/cli.hxx>
+
+extern char** environ;
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    std::string
+    read_file(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    /// The number of SHT_GROUP sections of a 64-bit little-endian ELF object, on a little-endian host; -1 if not one
+    long
+    comdat_groups(const std::string& object) {
+        constexpr const std::uint32_t sht_group = 17;
+        if (object.size() < 64 || object.compare(0, 4, "\177ELF") != 0
+            || object[4] != 2 || object[5] != 1) {
+            return -1;
+        }
+
+        auto read = [&object](std::size_t offset, auto value) {
+            if (offset + sizeof value <= object.size()) {
+                std::memcpy(&value, object.data() + offset, sizeof value);
+            }
+            return value;
+        };
+        auto shoff = read(0x28, std::uint64_t{});
+        auto shentsize = read(0x3a, std::uint16_t{});
+        auto shnum = read(0x3c, std::uint16_t{});
+
+        long groups = 0;
+        for (std::uint16_t i = 0; i < shnum; ++i) {
+            groups += read(shoff + std::uint64_t{i} * shentsize + 4, std::uint32_t{}) == sht_group;
+        }
+        return groups;
+    }
+
+    /// The number of events of the name in a -ftime-trace file
+    std::size_t
+    trace_events(const std::string& trace, std::string_view name) {
+        auto needle = fmt::format("\"name\":\"{}\"", name);
+        std::size_t count = 0;
+        for (auto pos = trace.find(needle); pos != std::string::npos; pos = trace.find(needle, pos + needle.size())) {
+            ++count;
+        }
+        return count;
+    }
+}
+
+int
+main(int argc, char** argv) try {
+    std::size_t options = 0;
+    std::string report;
+    bool summary = false;
+    ic::cli_parser cli{
+           "options"_opt >= "The amount of options declared in the compiled file" >>= options,
+           "report"_opt >= "The file to write the report to, besides the standard output" >>= report,
+           "summary"_opt >= "Print the reports given as operands, instead of compiling" >>= summary};
+    auto args = cli.forward(argc, argv, ic::forwarding::posix);
+
+    if (summary) {
+        for (int i = 1; i < argc; ++i) {
+            fmt::print("{}", read_file(args[i]));
+        }
+        return 0;
+    }
+    if (argc < 2) {
+        fmt::print(stderr, "cli-bench-compile-timer: error: no compiler command given\n");
+        return 1;
+    }
+
+    std::string object;
+    bool traced = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg = args[i];
+        if (arg == "-o" && i + 1 < argc) {
+            object = args[i + 1];
+        }
+        traced |= arg == "-ftime-trace";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid;
+    if (auto err = ::posix_spawnp(&pid, args[1], nullptr, nullptr, args + 1, environ); err != 0) {
+        fmt::print(stderr, "cli-bench-compile-timer: error: cannot run '{}': {}\n", args[1], std::strerror(err));
+        return 127;
+    }
+    int status = 0;
+    rusage usage{};
+    ::wait4(pid, &status, 0, &usage);
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+    }
+
+    auto seconds = [](const timeval& tv) {
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+    };
+    auto contents = object.empty() ? std::string() : read_file(object);
+    auto line = fmt::format("compile options={} wall={:.3f}s cpu={:.3f}s rss={}KiB object={}B comdat-groups={}",
+                            options,
+                            wall.count(),
+                            seconds(usage.ru_utime) + seconds(usage.ru_stime),
+                            usage.ru_maxrss,
+                            contents.size(),
+                            comdat_groups(contents));
+    if (traced) {// clang writes the trace next to the object, with its extension replaced
+        auto trace = read_file(object.substr(0, object.find_last_of('.')) + ".json");
+        line += fmt::format(" instantiated-classes={} instantiated-functions={}",
+                            trace_events(trace, "InstantiateClass"),
+                            trace_events(trace, "InstantiateFunction"));
+    }
+    line += '\n';
+
+    fmt::print("{}", line);
+    if (!report.empty()) {
+        std::ofstream(report, std::ios::trunc) << line;
+    }
+    return 0;
+} catch (const std::exception& err) {
+    fmt::print(stderr, "cli-bench-compile-timer: error: {}\n", err.what());
+    return 1;
+}
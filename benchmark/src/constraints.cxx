@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for the cost of checking constraints after parsing, with 256
+ * options, without constraints, and with 64 constraints of each kind.
+ */
+
+#include <string>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    constexpr const std::size_t options = 256;
+    constexpr const std::size_t constraints = 64;
+
+    std::string
+    name(std::size_t i) {
+        return "opt" + std::to_string(i);
+    }
+
+    ic::cli_parser
+    make_parser(std::vector<int>& vals) {
+        std::vector<ic::option> opts;
+        for (std::size_t i = 0; i < options; ++i) {
+            opts.push_back(info::_cli::option_builder(name(i)) >>= vals[i]);
+        }
+        return ic::cli_parser(std::move(opts));
+    }
+}
+
+TEST_CASE("Checking constraints on 256 options") {
+    std::vector<std::string> strs{"a.out"};
+    for (std::size_t i = 0; i < options; i += 2) {
+        strs.push_back("--" + name(i) + "=1");
+    }
+    std::vector<char*> args;
+    for (auto& str : strs) {
+        args.push_back(str.data());
+    }
+
+    std::vector<int> vals(options);
+    auto plain = make_parser(vals);
+    auto constrained = make_parser(vals);
+    for (std::size_t i = 0; i < constraints; ++i) {
+        auto a = name(i * 4);
+        auto b = name(i * 4 + 1);
+        auto c = name(i * 4 + 2);
+        auto d = name(i * 4 + 3);
+        constrained.constraints({ic::required(a),
+                                 ic::exactly_one_of(a, b),
+                                 ic::mutually_exclusive(c, d),
+                                 ic::implies(a, c)});
+    }
+
+    BENCHMARK("no constraints") {
+        return plain(args.size(), args.data()).size();
+    };
+
+    BENCHMARK("256 constraints") {
+        return constrained(args.size(), args.data()).size();
+    };
+}
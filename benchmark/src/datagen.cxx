@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * cli-bench-datagen: generates the data the benchmarks are built from.
+ *
+ * For a set of N options it writes the option definitions for every parser
+ * compared, and two kinds of inputs: the uniform ones every contender can
+ * parse, with each option given once as --option-N=666, and a workload of
+ * randomly mixed arguments for InfoCLI, drawn with set proportions from a
+ * seeded generator, so the same seed always makes the same workload. For
+ * the compile-time benchmarks it writes N option declarations cycling
+ * through the types, and the forms of the DSL.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <info/cli.hxx>
+
+using namespace info::cli::udl;
+
+namespace {
+    /// The short names of the flags of the workload; h is left for the Auto-Help
+    constexpr const std::string_view short_names = "abcdefgijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    /// The kinds of arguments in the workload
+    enum class kind {
+        packed,    ///< a group of packed short flags: -abc
+        unpacked,  ///< a short flag by itself: -a
+        gnu,       ///< a long option with its value: --option-N=V
+        non_gnu,   ///< a long option followed by its value: --option-N V
+        repeated,  ///< an aggregating option given again: --list-N=V
+        unknown,   ///< an option the parser does not know: --unknown-N=V
+        long_value,///< a string option with a long value: --text-N V
+    };
+
+    /// The relative weights of the kinds of arguments
+    struct mix {
+        int packed = 10;
+        int unpacked = 10;
+        int gnu = 30;
+        int non_gnu = 25;
+        int repeated = 15;
+        int unknown = 5;
+        int long_value = 5;
+    };
+
+    /// The options of the workload besides the N value options
+    struct workload_options {
+        std::size_t flags;
+        std::size_t lists;
+        std::size_t texts;
+
+        explicit workload_options(std::size_t n) noexcept
+             : flags(std::min(n, short_names.size())),
+               lists(std::max<std::size_t>(1, n / 20)),
+               texts(std::max<std::size_t>(1, n / 50)) { }
+    };
+
+    /// The random numbers of the workload; mt19937 is the same everywhere, the distributions are not
+    struct generator {
+        std::mt19937 rng;
+
+        explicit generator(std::uint32_t seed) : rng(seed) { }
+
+        /// A number in [0, n)
+        std::size_t
+        below(std::size_t n) {
+            return static_cast<std::size_t>(rng()) % n;
+        }
+
+        /// A number in [1, n]
+        std::size_t
+        index(std::size_t n) {
+            return below(n) + 1;
+        }
+
+        kind
+        pick(const mix& weights) {
+            const std::array<std::pair<int, kind>, 7> table{{{weights.packed, kind::packed},
+                                                             {weights.unpacked, kind::unpacked},
+                                                             {weights.gnu, kind::gnu},
+                                                             {weights.non_gnu, kind::non_gnu},
+                                                             {weights.repeated, kind::repeated},
+                                                             {weights.unknown, kind::unknown},
+                                                             {weights.long_value, kind::long_value}}};
+            int total = 0;
+            for (const auto& [weight, _] : table) {
+                total += weight;
+            }
+            auto roll = static_cast<int>(below(static_cast<std::size_t>(total)));
+            for (const auto& [weight, k] : table) {
+                if (roll < weight) {
+                    return k;
+                }
+                roll -= weight;
+            }
+            return kind::gnu;
+        }
+    };
+
+    /// Collects the contents of a data file
+    struct data_file {
+        std::string path;
+        std::string contents;
+
+        /// Writes the file if its contents differ, to not trigger needless rebuilds
+        void
+        write() const {
+            {
+                std::ifstream in(path, std::ios::binary);
+                std::string old((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+                if (in && old == contents) {
+                    return;
+                }
+            }
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << contents;
+            if (!out) {
+                throw std::runtime_error(fmt::format("cannot write '{}'", path));
+            }
+        }
+    };
+
+    void
+    write_uniform(const std::string& prefix, std::size_t n) {
+        data_file non_gnu{prefix + "input.non-gnu.txt", {}};
+        data_file gnu{prefix + "input.gnu.txt", {}};
+        data_file boost{prefix + "boost.txt", {}};
+        data_file cxxopts{prefix + "cxxopts.txt", {}};
+        data_file info{prefix + "info.txt", {}};
+        data_file callbacks{prefix + "info.callbacks.txt", {}};
+        data_file getopt{prefix + "gnu.opt.txt", {}};
+        data_file getopt_help{prefix + "gnu.help.txt", {}};
+        data_file getopt_check{prefix + "gnu.check.txt", {}};
+        data_file schema{prefix + "schema.infocli", fmt::format("# The options of the {} option benchmarks\n", n)};
+
+        for (std::size_t i = 1; i <= n; ++i) {
+            non_gnu.contents += fmt::format("\"--option-{}\", \"666\", ", i);
+            gnu.contents += fmt::format("\"--option-{}=666\", ", i);
+            boost.contents += fmt::format("(\"option-{0}\", po::value<int>(&a<{0}>), \"some help -- {0}\")", i);
+            cxxopts.contents += fmt::format("(\"option-{0}\", \"some help -- {0}\", cxo::value<int>(a<{0}>))", i);
+            info.contents += fmt::format("\"option-{0}\"_opt >= \"some help -- {0}\" >>= a<{0}>,", i);
+            callbacks.contents += fmt::format("ic::make_callback(a<{}>),", i);
+            getopt.contents += fmt::format("{{\"option-{}\", required_argument, 0, 0}},", i);
+            getopt_help.contents += fmt::format("\"some help -- {}\",", i);
+            getopt_check.contents += fmt::format("if (strcmp(long_opts[opt_idx].name, \"option-{0}\") == 0) {{a<{0}> = atoi(optarg);}}", i);
+            schema.contents += fmt::format("option_{0} option-{0} int \"some help -- {0}\"\n", i);
+        }
+        schema.contents += "option_9999 option-9999 int \"more help -- 9999\"\n";
+
+        for (const auto* file : {&non_gnu, &gnu, &boost, &cxxopts, &info, &callbacks, &getopt, &getopt_help, &getopt_check, &schema}) {
+            file->write();
+        }
+    }
+
+    void
+    write_compile(const std::string& prefix, std::size_t n) {
+        constexpr const std::array<std::string_view, 10> types{"int", "bool", "std::string", "double", "std::vector<int>",
+                                                               "std::string_view", "char", "unsigned long", "float",
+                                                               "std::vector<std::string>"};
+
+        data_file info{prefix + "compile.info.txt", {}};
+        for (std::size_t i = 1; i <= n; ++i) {
+            auto type = types[i % types.size()];
+            switch (i % 3) {
+            case 0:
+                info.contents += fmt::format("\"option-{0}\"_opt >>= v<{1}, {0}>,\n", i, type);
+                break;
+            case 1:
+                info.contents += fmt::format("\"option-{0}\"_opt >= \"some help -- {0}\" >>= v<{1}, {0}>,\n", i, type);
+                break;
+            case 2:
+                info.contents += fmt::format("\"option-{0}\"_opt / \"alias-{0}\" >= \"some help -- {0}\" >>= v<{1}, {0}>,\n", i, type);
+                break;
+            }
+        }
+        info.write();
+    }
+
+    void
+    write_workload(const std::string& prefix,
+                   std::size_t n,
+                   std::size_t arguments,
+                   std::size_t value_length,
+                   const mix& weights,
+                   generator& gen) {
+        workload_options opts(n);
+
+        data_file info{prefix + "workload.info.txt", {}};
+        for (std::size_t i = 1; i <= n; ++i) {
+            info.contents += fmt::format("\"option-{0}\"_opt >>= a<{0}>,\n", i);
+        }
+        for (std::size_t i = 1; i <= opts.flags; ++i) {
+            info.contents += fmt::format("'{}'_opt / \"flag-{}\" >>= flag<{}>,\n", short_names[i - 1], i, i);
+        }
+        for (std::size_t i = 1; i <= opts.lists; ++i) {
+            info.contents += fmt::format("\"list-{0}\"_opt >>= list<{0}>,\n", i);
+        }
+        for (std::size_t i = 1; i <= opts.texts; ++i) {
+            info.contents += fmt::format("\"text-{0}\"_opt >>= text<{0}>,\n", i);
+        }
+
+        data_file args{prefix + "workload.args.txt", {}};
+        for (std::size_t i = 0; i < arguments; ++i) {
+            switch (gen.pick(weights)) {
+            case kind::packed: {
+                std::string group;
+                for (auto len = 2 + gen.below(3); len > 0; --len) {
+                    group += short_names[gen.below(opts.flags)];
+                }
+                args.contents += fmt::format("\"-{}\", ", group);
+                break;
+            }
+            case kind::unpacked:
+                args.contents += fmt::format("\"-{}\", ", short_names[gen.below(opts.flags)]);
+                break;
+            case kind::gnu:
+                args.contents += fmt::format("\"--option-{}={}\", ", gen.index(n), gen.below(1000));
+                break;
+            case kind::non_gnu:
+                args.contents += fmt::format("\"--option-{}\", \"{}\", ", gen.index(n), gen.below(1000));
+                break;
+            case kind::repeated:
+                args.contents += fmt::format("\"--list-{}={}\", ", gen.index(opts.lists), gen.below(1000));
+                break;
+            case kind::unknown:
+                args.contents += fmt::format("\"--unknown-{}={}\", ", gen.index(n), gen.below(1000));
+                break;
+            case kind::long_value: {
+                std::string value(value_length / 2 + gen.below(value_length / 2 + 1), '\0');
+                for (auto& c : value) {
+                    c = static_cast<char>('a' + gen.below(26));
+                }
+                args.contents += fmt::format("\"--text-{}\", \"{}\", ", gen.index(opts.texts), value);
+                break;
+            }
+            }
+            args.contents += '\n';
+        }
+
+        info.write();
+        args.write();
+    }
+}
+
+int
+main(int argc, char** argv) try {
+    std::size_t n = 0;
+    std::size_t arguments = 0;
+    std::uint32_t seed = 1;
+    std::size_t value_length = 1024;
+    std::string output = ".";
+    mix weights;
+    info::cli::cli_parser cli{
+           'n'_opt / "options" >= "The amount of options in the set, N" >>= n,
+           'a'_opt / "arguments" >= "The amount of arguments in the workload [N]" >>= arguments,
+           's'_opt / "seed" >= "The seed of the workload [1]" >>= seed,
+           'o'_opt / "output" >= "The directory to write the data files to [.]" >>= output,
+           "value-length"_opt >= "The longest value of the text options [1024]" >>= value_length,
+           "packed"_opt >= "The weight of packed short flags: -abc [10]" >>= weights.packed,
+           "unpacked"_opt >= "The weight of short flags by themselves: -a [10]" >>= weights.unpacked,
+           "gnu"_opt >= "The weight of GNU-style long options: --option-N=V [30]" >>= weights.gnu,
+           "non-gnu"_opt >= "The weight of long options with separate values: --option-N V [25]" >>= weights.non_gnu,
+           "repeated"_opt >= "The weight of repeated aggregating options: --list-N=V [15]" >>= weights.repeated,
+           "unknown"_opt >= "The weight of unknown options: --unknown-N=V [5]" >>= weights.unknown,
+           "long-value"_opt >= "The weight of text options with long values: --text-N V [5]" >>= weights.long_value};
+    cli(argc, argv);
+
+    if (n == 0) {
+        fmt::print(stderr, "cli-bench-datagen: error: the amount of options must be given, see --help\n");
+        return 1;
+    }
+    if (weights.packed < 0 || weights.unpacked < 0 || weights.gnu < 0 || weights.non_gnu < 0
+        || weights.repeated < 0 || weights.unknown < 0 || weights.long_value < 0
+        || weights.packed + weights.unpacked + weights.gnu + weights.non_gnu
+                     + weights.repeated + weights.unknown + weights.long_value
+                 == 0) {
+        fmt::print(stderr, "cli-bench-datagen: error: the weights must not be negative, nor all zero\n");
+        return 1;
+    }
+    if (arguments == 0) {
+        arguments = n;
+    }
+
+    auto prefix = fmt::format("{}/{}.", output, n);
+    generator gen(seed);
+    write_uniform(prefix, n);
+    write_workload(prefix, n, arguments, value_length, weights, gen);
+    write_compile(prefix, n);
+    return 0;
+} catch (const std::exception& err) {
+    fmt::print(stderr, "cli-bench-datagen: error: {}\n", err.what());
+    return 1;
+}
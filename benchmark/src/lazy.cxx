@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for parsing 10'000 floating point values eagerly and lazily,
+ * where the lazy values are either never used, or used after parsing.
+ */
+
+#include <string>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+#include <info/cli/extra/lazy.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    constexpr const std::size_t values = 10'000;
+
+    struct owned_args {
+        explicit owned_args(std::vector<std::string> args)
+             : strings(std::move(args)) {
+            for (auto& str : strings) {
+                ptrs.push_back(str.data());
+            }
+        }
+
+        std::size_t
+        size() const noexcept { return ptrs.size(); }
+
+        char**
+        data() noexcept { return ptrs.data(); }
+
+        std::vector<std::string> strings;
+        std::vector<char*> ptrs;
+    };
+}
+
+TEST_CASE("Parsing 10k values eagerly and lazily") {
+    std::vector<std::string> strs{"a.out"};
+    for (std::size_t i = 0; i < values; ++i) {
+        strs.push_back("-s" + std::to_string(i) + ".0625e-3");
+    }
+    owned_args args{std::move(strs)};
+
+    BENCHMARK("eager") {
+        std::vector<double> samples;
+        ic::cli_parser cli{'s'_opt >>= samples};
+        cli(args.size(), args.data());
+        return samples.size();
+    };
+
+    BENCHMARK("lazy, never used") {
+        ic::lazy<std::vector<double>> samples;
+        ic::cli_parser cli{'s'_opt >>= samples};
+        cli(args.size(), args.data());
+        return samples.given();
+    };
+
+    BENCHMARK("lazy, used") {
+        ic::lazy<std::vector<double>> samples;
+        ic::cli_parser cli{'s'_opt >>= samples};
+        cli(args.size(), args.data());
+        return samples->size();
+    };
+}
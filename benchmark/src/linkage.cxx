@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for parsing the same command line with InfoCLI used as a shared
+ * library, a static library, and header-only. Built once for each, with the
+ * name of the build in CLI_LINKAGE, and without LTO, so only the header-only
+ * build can inline the library into the callbacks.
+ */
+
+#include <string>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    constexpr const std::size_t repeats = 1'000;
+
+    struct owned_args {
+        explicit owned_args(std::vector<std::string> args)
+             : strings(std::move(args)) {
+            for (auto& str : strings) {
+                ptrs.push_back(str.data());
+            }
+        }
+
+        std::size_t
+        size() const noexcept { return ptrs.size(); }
+
+        char**
+        data() noexcept { return ptrs.data(); }
+
+        std::vector<std::string> strings;
+        std::vector<char*> ptrs;
+    };
+}
+
+TEST_CASE("Parsing a mixed command line " CLI_LINKAGE) {
+    int jobs = 0;
+    long seed = 0;
+    double scale = 0;
+    bool verbose = false;
+    std::string output;
+    std::vector<int> levels;
+    std::vector<std::string> inputs;
+    ic::cli_parser cli{
+           'j'_opt / "jobs" >>= jobs,
+           "seed"_opt >>= seed,
+           's'_opt / "scale" >>= scale,
+           'v'_opt >>= verbose,
+           'o'_opt / "output" >>= output,
+           'l'_opt >>= levels,
+           'i'_opt / "input" >>= inputs};
+
+    std::vector<std::string> strs{"a.out"};
+    for (std::size_t i = 0; i < repeats; ++i) {
+        auto n = std::to_string(i);
+        strs.insert(strs.end(), {"-j" + n,
+                                 "--seed=" + n + "123456",
+                                 "-s", n + ".25",
+                                 "-vl" + n,
+                                 "--output", "out" + n,
+                                 "--input=in" + n,
+                                 "operand" + n});
+    }
+    owned_args args{std::move(strs)};
+
+    BENCHMARK(CLI_LINKAGE) {
+        levels.clear();
+        inputs.clear();
+        return cli(args.size(), args.data()).size();
+    };
+}
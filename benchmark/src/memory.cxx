@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Memory profile of cli_parser construction, parsing, and the Auto-Help,
+ * for parsers of 10 to 100k options. The global operator new is replaced to
+ * count the allocations, the bytes allocated, and the peak of the bytes
+ * alive; the peak RSS is sampled from the system. Every phase is reported as
+ * a warning of key=value pairs next to the timings of the benchmarks, so
+ * reporters like -r xml put them in the same machine-readable output.
+ *
+ * The Auto-Help exits, so it runs in a forked child, which reports its
+ * numbers through a pipe when exiting.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> allocated{0};
+    std::atomic<std::size_t> alive{0};
+    std::atomic<std::size_t> peak{0};
+
+    /// The room before every allocation, where its size is kept
+    constexpr const std::size_t header = alignof(std::max_align_t);
+
+    void*
+    counted_new(std::size_t size, std::size_t align) noexcept {
+        auto room = align > header ? align : header;
+        void* base = nullptr;
+        if (::posix_memalign(&base, room, room + size) != 0) {
+            return nullptr;
+        }
+        auto ptr = static_cast<char*>(base) + room;
+        reinterpret_cast<std::size_t*>(ptr)[-1] = size;
+        reinterpret_cast<std::size_t*>(ptr)[-2] = room;
+
+        ++allocations;
+        allocated += size;
+        auto now = alive += size;
+        for (auto old = peak.load(); now > old && !peak.compare_exchange_weak(old, now);) { }
+        return ptr;
+    }
+
+    void
+    counted_delete(void* ptr) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        auto size = static_cast<std::size_t*>(ptr)[-1];
+        auto room = static_cast<std::size_t*>(ptr)[-2];
+        alive -= size;
+        std::free(static_cast<char*>(ptr) - room);
+    }
+
+    void*
+    counted_new_or_throw(std::size_t size, std::size_t align) {
+        if (auto ptr = counted_new(size == 0 ? 1 : size, align)) {
+            return ptr;
+        }
+        throw std::bad_alloc{};
+    }
+}
+
+void* operator new(std::size_t size) { return counted_new_or_throw(size, header); }
+void* operator new[](std::size_t size) { return counted_new_or_throw(size, header); }
+void* operator new(std::size_t size, std::align_val_t al) { return counted_new_or_throw(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return counted_new_or_throw(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_new(size == 0 ? 1 : size, header); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_new(size == 0 ? 1 : size, header); }
+void operator delete(void* ptr) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+
+namespace {
+    /// The numbers of a phase
+    struct usage {
+        std::size_t allocations;
+        std::size_t bytes;
+        std::size_t peak_bytes;///< The most bytes alive at once, over what was alive before the phase
+        std::size_t peak_rss_kb;
+    };
+
+    /// Resets the peak RSS of the process, where the system allows it
+    void
+    reset_peak_rss() {
+#ifdef __linux__
+        std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+    }
+
+    /// The peak RSS since the last reset on Linux, or of the whole process elsewhere
+    std::size_t
+    peak_rss_kb() {
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        for (std::string line; std::getline(status, line);) {
+            if (line.compare(0, 6, "VmHWM:") == 0) {
+                return std::stoul(line.substr(6));
+            }
+        }
+#endif
+        rusage ru{};
+        ::getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+        return static_cast<std::size_t>(ru.ru_maxrss) / 1024;
+#else
+        return static_cast<std::size_t>(ru.ru_maxrss);
+#endif
+    }
+
+    /// Measures the allocations and the peak RSS from its construction
+    struct phase {
+        std::size_t allocations_before = allocations.load();
+        std::size_t allocated_before = allocated.load();
+        std::size_t alive_before = alive.load();
+
+        phase() {
+            peak = alive.load();
+            reset_peak_rss();
+        }
+
+        usage
+        finish() const {
+            return {allocations.load() - allocations_before,
+                    allocated.load() - allocated_before,
+                    peak.load() - alive_before,
+                    peak_rss_kb()};
+        }
+    };
+
+    void
+    report(const char* name, std::size_t options, usage use) {
+        WARN("memory phase=" << name
+                             << " options=" << options
+                             << " allocations=" << use.allocations
+                             << " bytes=" << use.bytes
+                             << " peak_bytes=" << use.peak_bytes
+                             << " peak_rss_kb=" << use.peak_rss_kb);
+    }
+
+    struct owned_args {
+        explicit owned_args(std::vector<std::string> args)
+             : strings(std::move(args)) {
+            for (auto& str : strings) {
+                ptrs.push_back(str.data());
+            }
+        }
+
+        std::size_t
+        size() const noexcept { return ptrs.size(); }
+
+        char**
+        data() noexcept { return ptrs.data(); }
+
+        std::vector<std::string> strings;
+        std::vector<char*> ptrs;
+    };
+
+    std::vector<ic::option>
+    make_options(std::vector<int>& values) {
+        std::vector<ic::option> ret;
+        ret.reserve(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            auto name = "option-" + std::to_string(i);
+            auto help = "some help -- " + std::to_string(i);
+            ret.push_back(ic::udl::operator""_opt(name.data(), name.size()) >= help >>= values[i]);
+        }
+        return ret;
+    }
+
+    owned_args
+    make_args(std::size_t options) {
+        std::vector<std::string> args{"a.out"};
+        for (std::size_t i = 0; i < options; ++i) {
+            args.push_back("--option-" + std::to_string(i) + "=5");
+        }
+        return owned_args(std::move(args));
+    }
+
+    /// Runs the Auto-Help in a child process, which writes its usage to the pipe when exiting
+    usage
+    help_usage(ic::cli_parser& cli) {
+        static int report_fd = -1;
+        static phase* help_phase = nullptr;
+
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        auto pid = ::fork();
+        REQUIRE(pid != -1);
+        if (pid == 0) {
+            ::close(fds[0]);
+            auto null = ::open("/dev/null", O_WRONLY);
+            ::dup2(null, STDOUT_FILENO);
+
+            report_fd = fds[1];
+            std::atexit([] {
+                std::fflush(stdout);
+                auto use = help_phase->finish();
+                [[maybe_unused]] auto written = ::write(report_fd, &use, sizeof use);
+            });
+            owned_args args({"a.out", "--help"});
+            help_phase = new phase;
+            cli(args.size(), args.data());
+            ::_exit(2);// the Auto-Help did not exit
+        }
+
+        ::close(fds[1]);
+        usage use{};
+        auto got = ::read(fds[0], &use, sizeof use);
+        ::close(fds[0]);
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        CHECK(got == static_cast<ssize_t>(sizeof use));
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == 1);
+        return use;
+    }
+}
+
+TEST_CASE("Memory of cli_parser construction, parsing, and help") {
+    for (std::size_t options : {10u, 100u, 1'000u, 10'000u, 100'000u}) {
+        std::vector<int> values(options);
+        auto args = make_args(options);
+
+        auto opts = make_options(values);
+        phase construction;
+        ic::cli_parser cli(std::move(opts));
+        report("construction", options, construction.finish());
+
+        std::vector<std::string_view> ops;
+        {
+            phase parse;
+            ops = cli(args.size(), args.data());
+            report("parse", options, parse.finish());
+        }
+        CHECK(ops.size() == 1);
+        CHECK(values.back() == 5);
+
+        report("help", options, help_usage(cli));
+
+        BENCHMARK("construction of " + std::to_string(options)) {
+            return ic::cli_parser(make_options(values));
+        };
+        BENCHMARK("parse of " + std::to_string(options)) {
+            return cli(args.size(), args.data());
+        };
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for parsing 1'000'000 numeric operands, by hand from the returned
+ * or the streamed operands, and directly into a typed operand slot.
+ */
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    constexpr const std::size_t values = 1'000'000;
+
+    struct owned_args {
+        explicit owned_args(std::vector<std::string> args)
+             : strings(std::move(args)) {
+            for (auto& str : strings) {
+                ptrs.push_back(str.data());
+            }
+        }
+
+        std::size_t
+        size() const noexcept { return ptrs.size(); }
+
+        char**
+        data() noexcept { return ptrs.data(); }
+
+        std::vector<std::string> strings;
+        std::vector<char*> ptrs;
+    };
+}
+
+TEST_CASE("Parsing 1M numeric operands") {
+    std::vector<std::string> strs{"a.out", "-v"};
+    for (std::size_t i = 0; i < values; ++i) {
+        strs.push_back(std::to_string(i * 7919 % 1'000'003));
+    }
+    owned_args args{std::move(strs)};
+
+    BENCHMARK("returned operands, parsed by hand") {
+        bool verbose = false;
+        ic::cli_parser cli{'v'_opt >>= verbose};
+        auto ops = cli(args.size(), args.data());
+
+        std::vector<int> ids;
+        ids.reserve(ops.size() - 1);
+        for (auto it = ops.begin() + 1; it != ops.end(); ++it) {
+            int id;
+            std::from_chars(it->data(), it->data() + it->size(), id);
+            ids.push_back(id);
+        }
+        return ids.size();
+    };
+
+    BENCHMARK("streamed operands, parsed by hand") {
+        bool verbose = false;
+        ic::cli_parser cli{'v'_opt >>= verbose};
+
+        std::vector<int> ids;
+        ids.reserve(values);
+        bool program = true;
+        cli(args.size(), args.data(), [&ids, &program](std::string_view op) {
+            if (program) {
+                program = false;
+                return;
+            }
+            int id;
+            std::from_chars(op.data(), op.data() + op.size(), id);
+            ids.push_back(id);
+        });
+        return ids.size();
+    };
+
+    BENCHMARK("typed operand slot") {
+        bool verbose = false;
+        std::vector<int> ids;
+        ic::cli_parser cli{'v'_opt >>= verbose,
+                           ic::operands("ids") >>= ids};
+        cli(args.size(), args.data());
+        return ids.size();
+    };
+
+    BENCHMARK("typed operand slot, presized") {
+        bool verbose = false;
+        std::vector<int> ids;
+        ic::cli_parser cli{'v'_opt >>= verbose,
+                           ic::operands("ids") >>= ids};
+        cli.presize(true);
+        cli(args.size(), args.data());
+        return ids.size();
+    };
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for long lists of repeated options aggregated into vectors, with
+ * and without the counting pre-pass. Allocations are counted by replacing the
+ * global operator new.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+
+namespace ic = info::cli;
+using namespace info::cli::udl;
+
+namespace {
+    std::atomic<std::size_t> allocations{0};
+}
+
+void*
+operator new(std::size_t size) {
+    ++allocations;
+    if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void
+operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+    struct owned_args {
+        explicit owned_args(std::vector<std::string> args)
+             : strings(std::move(args)) {
+            for (auto& str : strings) {
+                ptrs.push_back(str.data());
+            }
+        }
+
+        std::size_t
+        size() const noexcept { return ptrs.size(); }
+
+        char**
+        data() noexcept { return ptrs.data(); }
+
+        std::vector<std::string> strings;
+        std::vector<char*> ptrs;
+    };
+
+    /// -I and --define pairs, with values short enough for SSO, so only the
+    /// vectors' own allocations are counted
+    owned_args
+    workload(std::size_t n) {
+        std::vector<std::string> args{"a.out"};
+        for (std::size_t i = 0; i < n; ++i) {
+            args.emplace_back("-I");
+            args.emplace_back("/inc/" + std::to_string(i));
+            args.emplace_back("--define=D" + std::to_string(i));
+        }
+        return owned_args(std::move(args));
+    }
+}
+
+TEST_CASE("Repeated options into vectors") {
+    std::vector<std::string> includes;
+    std::vector<std::string> defines;
+    ic::cli_parser cli{
+           'I'_opt / "include" >>= includes,
+           'D'_opt / "define" >>= defines};
+
+    auto reset = [&] {// moving from empty ones releases the capacity
+        includes = std::vector<std::string>();
+        defines = std::vector<std::string>();
+    };
+
+    for (std::size_t n : {1'000u, 50'000u}) {
+        auto args = workload(n);
+
+        for (bool presize : {false, true}) {
+            cli.presize(presize);
+            auto name = std::to_string(n) + (presize ? " with presize" : " without presize");
+
+            reset();
+            auto before = allocations.load();
+            cli(args.size(), args.data());
+            WARN(name << ": " << allocations.load() - before << " allocations");
+            CHECK(includes.size() == n);
+
+            BENCHMARK(std::move(name)) {
+                reset();
+                return cli(args.size(), args.data());
+            };
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for starting a tool using InfoCLI, from exec to the end of its
+ * parsing, with InfoCLI as a shared and as a static library. The dynamic
+ * linker resolves the symbols either lazily, on first call, or all before
+ * main with LD_BIND_NOW, which shows the full cost of the relocations of
+ * the shared library.
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+extern char** environ;
+
+namespace {
+    /// The environment without LD_BIND_NOW, and with it if bind_now
+    std::vector<char*>
+    environment(bool bind_now) {
+        static std::string bind_now_var = "LD_BIND_NOW=1";
+        std::vector<char*> ret;
+        for (auto env = environ; *env != nullptr; ++env) {
+            if (std::string(*env).compare(0, 12, "LD_BIND_NOW=") != 0) {
+                ret.push_back(*env);
+            }
+        }
+        if (bind_now) {
+            ret.push_back(bind_now_var.data());
+        }
+        ret.push_back(nullptr);
+        return ret;
+    }
+
+    /// Runs the tool to completion, returns its exit status
+    int
+    run(const char* tool, std::vector<char*>& env) {
+        auto args = std::array{const_cast<char*>(tool),
+                               const_cast<char*>("-j4"),
+                               const_cast<char*>("--seed=42"),
+                               const_cast<char*>("-vl1"),
+                               const_cast<char*>("--output"),
+                               const_cast<char*>("out.txt"),
+                               const_cast<char*>("--input=in.txt"),
+                               const_cast<char*>("operand"),
+                               static_cast<char*>(nullptr)};
+        pid_t pid;
+        if (::posix_spawn(&pid, tool, nullptr, nullptr, args.data(), env.data()) != 0) {
+            return -1;
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+}
+
+TEST_CASE("Starting a tool using InfoCLI") {
+    const std::array<std::pair<const char*, const char*>, 2> tools{{{"shared", CLI_STARTUP_TOOL_SHARED},
+                                                                    {"static", CLI_STARTUP_TOOL_STATIC}}};
+
+    for (bool bind_now : {false, true}) {
+        auto env = environment(bind_now);
+        for (const auto& [linkage, tool] : tools) {
+            REQUIRE(run(tool, env) == 0);
+
+            BENCHMARK(std::string(linkage) + (bind_now ? " with LD_BIND_NOW" : " with lazy binding")) {
+                return run(tool, env);
+            };
+        }
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * A small tool, as InfoCLI's users ship: parses its command line and exits.
+ * Built against InfoCLI as a shared and as a static library, and started
+ * by cli-bench-startup, which times it from exec to the end of the parsing.
+ */
+
+#include <string>
+#include <vector>
+
+#include <info/cli.hxx>
+
+using namespace info::cli::udl;
+
+int
+main(int argc, char** argv) {
+    int jobs = 0;
+    long seed = 0;
+    double scale = 0;
+    bool verbose = false;
+    std::string output;
+    std::vector<int> levels;
+    std::vector<std::string> inputs;
+    info::cli::cli_parser cli{
+           'j'_opt / "jobs" >= "The amount of jobs to run" >>= jobs,
+           "seed"_opt >= "The seed of the run" >>= seed,
+           's'_opt / "scale" >= "The scale of the output" >>= scale,
+           'v'_opt / "verbose" >= "Whether to print more" >>= verbose,
+           'o'_opt / "output" >= "The file to write" >>= output,
+           'l'_opt / "level" >= "The levels to use" >>= levels,
+           'i'_opt / "input" >= "The files to read" >>= inputs};
+
+    auto ops = cli(argc, argv);
+    return static_cast<int>(ops.size() + levels.size() + inputs.size()) == 0 ? 1 : 0;
+}
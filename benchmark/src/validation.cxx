@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Benchmark for validating 10'000 paths after parsing, with a growing
+ * amount of validation threads. Half of the paths exist.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <info/cli.hxx>
+#include <info/cli/exc/validation_error.hxx>
+
+namespace ic = info::cli;
+namespace fs = std::filesystem;
+using namespace info::cli::udl;
+
+namespace {
+    constexpr const std::size_t paths = 10'000;
+
+    struct owned_args {
+        explicit owned_args(std::vector<std::string> args)
+             : strings(std::move(args)) {
+            for (auto& str : strings) {
+                ptrs.push_back(str.data());
+            }
+        }
+
+        std::size_t
+        size() const noexcept { return ptrs.size(); }
+
+        char**
+        data() noexcept { return ptrs.data(); }
+
+        std::vector<std::string> strings;
+        std::vector<char*> ptrs;
+    };
+
+    bool
+    readable(std::string_view path) {
+        std::ifstream file{std::string(path)};
+        return file.good() || !fs::exists(path);// missing files are fine, only unreadable ones are not
+    }
+}
+
+TEST_CASE("Validating 10k paths") {
+    auto dir = fs::temp_directory_path() / "info-cli-bench-validation";
+    fs::create_directories(dir);
+
+    std::vector<std::string> args{"a.out"};
+    for (std::size_t i = 0; i < paths; ++i) {
+        auto path = (dir / std::to_string(i)).string();
+        if (i % 2 == 0) {
+            std::ofstream{path} << i;
+        }
+        args.emplace_back("-f");
+        args.emplace_back(std::move(path));
+    }
+    owned_args argv(std::move(args));
+
+    std::vector<std::string> files;
+    ic::cli_parser cli{
+           'f'_opt / "file" >>= files | ic::validate(readable)};
+
+    auto hw = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= std::max(hw, 4u); threads *= 2) {
+        cli.validation_threads(threads);
+        BENCHMARK(std::to_string(threads) + " threads") {
+            files.clear();
+            return cli(argv.size(), argv.data());
+        };
+    }
+
+    fs::remove_all(dir);
+}
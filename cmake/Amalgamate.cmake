@@ -0,0 +1,136 @@
+## BSD 3-Clause License
+#
+# Copyright (c) 2020, bodand
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+## Creates the amalgamated single header of InfoCLI
+##
+## Script mode only: cmake -DSOURCE_DIR=<repo> -DOUTPUT=<file> [-DVERSION=<ver>] -P Amalgamate.cmake
+##
+## Starts from <info/cli.hxx> and inlines every InfoCLI header and, as the
+## header-only mode includes them, every source file, each once, in the order
+## the preprocessor would first see them. Headers not reachable from
+## <info/cli.hxx> are appended afterwards. Includes of other libraries are kept.
+
+cmake_minimum_required(VERSION 3.16)
+
+if (NOT DEFINED SOURCE_DIR OR NOT DEFINED OUTPUT)
+    message(FATAL_ERROR "Amalgamate.cmake requires SOURCE_DIR and OUTPUT")
+endif ()
+
+set(_INCLUDE_REGEX "\n[ \t]*#[ \t]*include[ \t]*[<\"][^>\"\n]+[>\"]")
+
+## ResolveInclude(Directive CurrentDir ResolvedPath)
+##
+## Returns the absolute path of the InfoCLI file included by the directive
+## through ResolvedPath, or the empty string if it is not an InfoCLI file
+function(ResolveInclude isDirective isCurrentDir osResolvedPath)
+    string(STRIP "${isDirective}" isDirective)
+    string(REGEX REPLACE "^#[ \t]*include[ \t]*([<\"])([^>\"]+)[>\"]$" "\\1" ssQuote "${isDirective}")
+    string(REGEX REPLACE "^#[ \t]*include[ \t]*([<\"])([^>\"]+)[>\"]$" "\\2" ssPath "${isDirective}")
+
+    set(ssResolved "")
+    if (ssQuote STREQUAL "\"")
+        get_filename_component(ssResolved "${isCurrentDir}/${ssPath}" ABSOLUTE)
+    elseif (ssPath MATCHES "^info/cli(\\.hxx|/)")
+        set(ssResolved "${SOURCE_DIR}/include/${ssPath}")
+    endif ()
+    if (NOT ssResolved STREQUAL "" AND NOT EXISTS "${ssResolved}")
+        message(FATAL_ERROR "Amalgamate.cmake: cannot find '${ssPath}' included from '${isCurrentDir}'")
+    endif ()
+
+    set("${osResolvedPath}" "${ssResolved}" PARENT_SCOPE)
+endfunction()
+
+## InlineFile(Path Content)
+##
+## Returns the contents of the file at Path through Content, with the InfoCLI
+## files it includes inlined recursively, unless they were already inlined
+function(InlineFile isPath osContent)
+    get_property(slVisited GLOBAL PROPERTY _CLI_AMALGAMATED)
+    if (isPath IN_LIST slVisited)
+        set("${osContent}" "" PARENT_SCOPE)
+        return()
+    endif ()
+    set_property(GLOBAL APPEND PROPERTY _CLI_AMALGAMATED "${isPath}")
+
+    file(READ "${isPath}" ssRest)
+    string(PREPEND ssRest "\n")
+    string(REGEX REPLACE "#pragma once[^\n]*\n" "" ssRest "${ssRest}")
+    file(RELATIVE_PATH ssName "${SOURCE_DIR}" "${isPath}")
+    get_filename_component(ssDir "${isPath}" DIRECTORY)
+
+    set(ssResult "// ---- ${ssName} ----\n")
+    while (TRUE)
+        string(REGEX MATCH "${_INCLUDE_REGEX}" ssDirective "${ssRest}")
+        if (ssDirective STREQUAL "")
+            break()
+        endif ()
+        string(FIND "${ssRest}" "${ssDirective}" ssAt)
+        string(LENGTH "${ssDirective}" ssLength)
+        string(SUBSTRING "${ssRest}" 0 ${ssAt} ssPrefix)
+        math(EXPR ssAfter "${ssAt} + ${ssLength}")
+        string(SUBSTRING "${ssRest}" ${ssAfter} -1 ssRest)
+
+        ResolveInclude("${ssDirective}" "${ssDir}" ssIncluded)
+        if (ssIncluded STREQUAL "")
+            string(APPEND ssResult "${ssPrefix}${ssDirective}")
+        else ()
+            InlineFile("${ssIncluded}" ssInlined)
+            string(APPEND ssResult "${ssPrefix}\n${ssInlined}")
+        endif ()
+    endwhile ()
+    string(APPEND ssResult "${ssRest}")
+
+    set("${osContent}" "${ssResult}" PARENT_SCOPE)
+endfunction()
+
+set_property(GLOBAL PROPERTY _CLI_AMALGAMATED "")
+InlineFile("${SOURCE_DIR}/include/info/cli.hxx" _CLI_CONTENT)
+
+file(GLOB_RECURSE _CLI_HEADERS "${SOURCE_DIR}/include/info/cli/*.hxx")
+list(SORT _CLI_HEADERS)
+foreach (_CLI_HEADER IN LISTS _CLI_HEADERS)
+    InlineFile("${_CLI_HEADER}" _CLI_HEADER_CONTENT)
+    string(APPEND _CLI_CONTENT "${_CLI_HEADER_CONTENT}")
+endforeach ()
+
+file(WRITE "${OUTPUT}" "/*
+ * InfoCLI ${VERSION} amalgamated single header
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Generated by cmake/Amalgamate.cmake from the sources of InfoCLI; do not edit.
+ * Contains the whole library, which is used header-only through it.
+ */
+#pragma once
+
+#undef INFO_CLI_HEADER_ONLY
+#define INFO_CLI_HEADER_ONLY 1
+
+${_CLI_CONTENT}")
@@ -0,0 +1,72 @@
+## BSD 3-Clause License
+#
+# Copyright (c) 2020, bodand
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+## info_cli_generate(Target Schema [NAME Name])
+##
+## Generates the parser of the option schema Schema with infocli-gen, and adds
+## it to the sources of Target. The generated header is named Name.hxx, which
+## is the stem of Schema by default, and is put in the include path of Target.
+## The parser is regenerated whenever the schema or infocli-gen changes.
+function(info_cli_generate iTarget isSchema)
+    cmake_parse_arguments(PARSE_ARGV 2 sArg "" "NAME" "")
+    if (NOT TARGET info::infocli-gen)
+        message(FATAL_ERROR "info_cli_generate requires infocli-gen, build InfoCLI with INFO_CLI_BUILD_GENERATOR")
+    endif ()
+
+    get_filename_component(sSchema "${isSchema}" ABSOLUTE)
+    if (sArg_NAME)
+        set(sName "${sArg_NAME}")
+    else ()
+        get_filename_component(sName "${sSchema}" NAME_WE)
+    endif ()
+
+    # the dependency on an alias is only resolved through its target
+    get_target_property(sGenerator info::infocli-gen ALIASED_TARGET)
+    if (NOT sGenerator)
+        set(sGenerator info::infocli-gen)
+    endif ()
+
+    set(sDir "${CMAKE_CURRENT_BINARY_DIR}/infocli-gen/${iTarget}")
+    file(MAKE_DIRECTORY "${sDir}")
+    add_custom_command(OUTPUT "${sDir}/${sName}.hxx" "${sDir}/${sName}.cxx"
+                       COMMAND $<TARGET_FILE:${sGenerator}> -o "${sDir}" -n "${sName}" "${sSchema}"
+                       DEPENDS "${sSchema}" ${sGenerator}
+                       COMMENT "Generating the InfoCLI parser '${sName}' for '${iTarget}'"
+                       VERBATIM
+                       )
+
+    target_sources("${iTarget}" PRIVATE
+                   "${sDir}/${sName}.hxx"
+                   "${sDir}/${sName}.cxx"
+                   )
+    target_include_directories("${iTarget}" PRIVATE
+                               "${sDir}"
+                               )
+endfunction()
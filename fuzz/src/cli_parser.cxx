@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * libFuzzer harness for cli_parser::operator().
+ * The input is split on NUL bytes into the arguments following argv[0].
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <info/cli.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/exc/callback_error.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+
+using namespace info::cli::udl;
+namespace ic = info::cli;
+
+namespace {
+    bool flag;
+    int count;
+    int num;
+    unsigned unum;
+    char ch;
+    float flt;
+    double dbl;
+    std::string str;
+    std::vector<int> nums;
+    std::vector<std::string> strs;
+
+    /// Every option kind the library supports; no help texts, so no Auto-Help
+    /// which would exit the fuzzer
+    ic::cli_parser&
+    parser(ic::unknown_behavior behavior) {
+        static ic::cli_parser cli{
+               'f'_opt / "flag" >>= flag,
+               'v'_opt / "verbose" >>= ic::repeat{count},
+               'i'_opt / "int" >>= num,
+               'u'_opt / "unsigned" >>= unum,
+               'c'_opt / "char" >>= ch,
+               'F'_opt / "float" >>= flt,
+               'd'_opt / "double" >>= dbl,
+               's'_opt / "string" >>= str,
+               'n'_opt / "num" >>= nums,
+               'S'_opt / "strings" >>= strs,
+               '.'_opt / "dot" >>= num,
+               "callback"_opt >>= [](int) {},
+        };
+        cli.unknown_behavior(behavior);
+        return cli;
+    }
+}
+
+extern "C" int
+LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    if (size == 0) return 0;
+
+    // the first byte picks the unknown option behavior
+    auto behavior = static_cast<ic::unknown_behavior>(data[0] % 3);
+    ++data;
+    --size;
+
+    // one owned buffer, so every argument is NUL-terminated exactly where
+    // the fuzzer put it, and ASan sees reads past the end
+    std::vector<char> buf(data, data + size);
+    buf.push_back('\0');
+
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>("fuzz"));
+    for (std::size_t i = 0; i < buf.size(); i += std::strlen(buf.data() + i) + 1) {
+        argv.push_back(buf.data() + i);
+    }
+    try {
+        parser(behavior)(argv.size(), argv.data());
+    } catch (const ic::no_such_option&) {
+    } catch (const ic::bad_option_value&) {
+    } catch (const ic::callback_error&) {
+    }
+
+    strs.clear();
+    nums.clear();
+    return 0;
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements emitting the sources of a generated parser
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "emit.hxx"
+#include "perfect_hash.hxx"
+
+namespace {
+    std::string
+    literal(const std::string& str) {
+        std::string ret = "\"";
+        for (char c : str) {
+            if (c == '"' || c == '\\') {
+                ret += '\\';
+            }
+            ret += c;
+        }
+        return ret += '"';
+    }
+
+    /// The options part of the usage line, the same as cli_parser::usage_options makes
+    std::string
+    usage_options(const std::vector<std::string>& names) {
+        std::string shorts;
+        bool has_long = false;
+        for (const auto& name : names) {
+            if (name.size() == 1) {
+                shorts += name;
+            } else {
+                has_long = true;
+            }
+        }
+        std::sort(shorts.begin(), shorts.end(), [](unsigned char a, unsigned char b) {
+            if (std::tolower(a) == std::tolower(b)) {
+                return std::isupper(a) != 0;
+            }
+            return std::tolower(a) < std::tolower(b);
+        });
+
+        std::string ret;
+        if (!shorts.empty()) {
+            ret = fmt::format(" [-{}] ", shorts);
+        }
+        if (has_long) {
+            ret += "[LONG_OPTIONS]";
+        }
+        return ret;
+    }
+
+    template<class C, class Fn>
+    std::string
+    joined(const C& items, Fn fn) {
+        std::string ret;
+        for (const auto& item : items) {
+            ret += fn(item);
+            ret += ", ";
+        }
+        if (!ret.empty()) {
+            ret.resize(ret.size() - 2);
+        }
+        return ret;
+    }
+}
+
+info::cli::gen::generated_sources
+info::cli::gen::emit(const schema& sch, const std::string& name, const std::string& origin) {
+    // the ids of the options are their index in the schema, the Auto-Help
+    // follows them, if there are helps and no option takes --help
+    std::vector<std::string> names;
+    std::vector<int> ids;
+    bool has_help = false;
+    for (std::size_t i = 0; i < sch.options.size(); ++i) {
+        const auto& opt = sch.options[i];
+        has_help = has_help || !opt.help.empty();
+        for (const auto& opt_name : opt.names) {
+            names.push_back(opt_name);
+            ids.push_back(static_cast<int>(i));
+        }
+    }
+    int help_id = -1;
+    if (has_help && std::find(names.begin(), names.end(), "help") == names.end()) {
+        help_id = static_cast<int>(sch.options.size());
+        for (const auto& help_name : {"help", "h"}) {
+            if (std::find(names.begin(), names.end(), help_name) == names.end()) {
+                names.emplace_back(help_name);
+                ids.push_back(help_id);
+            }
+        }
+    }
+    auto table = build_perfect_hash(names, ids);
+
+    auto qualified = sch.namespace_name.empty()
+                            ? sch.struct_name
+                            : fmt::format("{}::{}", sch.namespace_name, sch.struct_name);
+    auto banner = fmt::format("// Generated by infocli-gen from {}; do not edit.\n", origin);
+
+    generated_sources ret;
+    auto& hxx = ret.header;
+    hxx = banner;
+    hxx += "#pragma once\n\n"
+           "#include <cstddef>\n"
+           "#include <string_view>\n"
+           "#include <type_traits>\n"
+           "#include <vector>\n\n";
+    for (const auto& include : sch.includes) {
+        hxx += fmt::format("#include {}\n", include);
+    }
+    hxx += "#include <info/cli/generated_parser.hxx>\n\n";
+    if (!sch.namespace_name.empty()) {
+        hxx += fmt::format("namespace {} {{\n", sch.namespace_name);
+    }
+    hxx += fmt::format("struct {} {{\n", sch.struct_name);
+    for (const auto& opt : sch.options) {
+        if (opt.init.empty()) {
+            hxx += fmt::format("    std::remove_reference_t<info::cli::meta::referenced_type<{}>> {}{{}};\n", opt.type, opt.field);
+        } else {
+            hxx += fmt::format("    std::remove_reference_t<info::cli::meta::referenced_type<{}>> {} = {};\n", opt.type, opt.field, opt.init);
+        }
+    }
+    hxx += fmt::format("\n"
+                       "    std::vector<std::string_view> parse(std::size_t argc, char** argv);\n"
+                       "    std::vector<std::string_view> parse(int argc, char** argv);\n"
+                       "\n"
+                       "    static int find(std::string_view name) noexcept;\n"
+                       "    bool store(int id, std::string_view value, const char*& last);\n"
+                       "\n"
+                       "    static constexpr const int help_id = {};\n"
+                       "    static const info::cli::rt_type_data types[];\n"
+                       "    static const info::_cli::generated_help help;\n"
+                       "}};\n",
+                       help_id);
+    if (!sch.namespace_name.empty()) {
+        hxx += "}\n";
+    }
+
+    auto& cxx = ret.source;
+    cxx = banner;
+    cxx += fmt::format("#include \"{}.hxx\"\n\n"
+                       "#include <cstdint>\n\n"
+                       "namespace {{\n",
+                       name);
+    cxx += fmt::format("    constexpr const std::uint32_t seed = {}u;\n", table.seed);
+    cxx += fmt::format("    constexpr const std::uint32_t bucket_mask = {}u;\n", table.displacements.size() - 1);
+    cxx += fmt::format("    constexpr const std::uint32_t slot_mask = {}u;\n", table.slot_names.size() - 1);
+    cxx += fmt::format("    constexpr const std::uint32_t displacements[] = {{{}}};\n",
+                       joined(table.displacements, [](auto d) { return std::to_string(d); }));
+    cxx += fmt::format("    constexpr const std::string_view slot_names[] = {{{}}};\n",
+                       joined(table.slot_names, literal));
+    cxx += fmt::format("    constexpr const int slot_ids[] = {{{}}};\n",
+                       joined(table.slot_ids, [](auto id) { return std::to_string(id); }));
+
+    std::vector<std::string> help_entries;
+    for (std::size_t i = 0; i < sch.options.size(); ++i) {
+        const auto& opt = sch.options[i];
+        if (opt.help.empty()) {
+            continue;
+        }
+        cxx += fmt::format("    constexpr const std::string_view names_{}[] = {{{}}};\n",
+                           i,
+                           joined(opt.names, literal));
+        help_entries.push_back(fmt::format("{{{}, names_{}, {}, {}}}", opt.help, i, opt.names.size(), i));
+    }
+    if (!help_entries.empty()) {
+        cxx += fmt::format("    constexpr const info::_cli::generated_help_entry help_entries[] = {{\n"
+                           "           {}}};\n",
+                           joined(help_entries, [](const auto& entry) { return entry; }));
+    }
+    cxx += "}\n\n";
+
+    std::vector<std::string> types;
+    for (const auto& opt : sch.options) {
+        types.push_back(fmt::format("info::_cli::generated_type<{}>()", opt.type));
+    }
+    if (help_id != -1) {
+        types.emplace_back("info::_cli::generated_type<bool>()");
+    }
+    cxx += fmt::format("const info::cli::rt_type_data {}::types[] = {{\n"
+                       "       {}}};\n\n",
+                       qualified,
+                       joined(types, [](const auto& type) { return type; }));
+    if (help_entries.empty()) {
+        cxx += fmt::format("const info::_cli::generated_help {}::help{{{}, nullptr, 0, types}};\n\n",
+                           qualified,
+                           literal(usage_options(names)));
+    } else {
+        cxx += fmt::format("const info::_cli::generated_help {}::help{{{}, help_entries, {}, types}};\n\n",
+                           qualified,
+                           literal(usage_options(names)),
+                           help_entries.size());
+    }
+
+    cxx += fmt::format("int\n"
+                       "{}::find(std::string_view name) noexcept {{\n"
+                       "    auto hash = info::_cli::generated_hash(name, seed);\n"
+                       "    auto slot = info::_cli::generated_slot(hash, displacements[hash & bucket_mask]) & slot_mask;\n"
+                       "    return slot_names[slot] == name ? slot_ids[slot] : -1;\n"
+                       "}}\n\n",
+                       qualified);
+
+    cxx += fmt::format("bool\n"
+                       "{}::store(int id, std::string_view value, const char*& last) {{\n"
+                       "    switch (id) {{\n",
+                       qualified);
+    for (std::size_t i = 0; i < sch.options.size(); ++i) {
+        const auto& opt = sch.options[i];
+        cxx += fmt::format("    case {}: return info::_cli::parse_into<{}>({}, value, last);\n",
+                           i,
+                           opt.type,
+                           opt.field);
+    }
+    cxx += "    default: return false;\n"
+           "    }\n"
+           "}\n\n";
+
+    cxx += fmt::format("std::vector<std::string_view>\n"
+                       "{0}::parse(std::size_t argc, char** argv) {{\n"
+                       "    return info::_cli::generated_parse(*this, argc, argv);\n"
+                       "}}\n\n"
+                       "std::vector<std::string_view>\n"
+                       "{0}::parse(int argc, char** argv) {{\n"
+                       "    return parse(static_cast<std::size_t>(argc), argv);\n"
+                       "}}\n",
+                       qualified);
+    return ret;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Emits the C++ sources of a generated parser.
+ */
+#pragma once
+
+#include <string>
+
+#include "schema.hxx"
+
+namespace info::cli::gen {
+    /**
+     * \brief The sources of a generated parser
+     */
+    struct generated_sources {
+        std::string header;///< The header declaring the struct
+        std::string source;///< The source file defining its tables and functions
+    };
+
+    /**
+     * \brief Emits the parser of the schema
+     *
+     * The header defines a struct with a member for every option of the
+     * schema, and a parse function filling them. The source file contains
+     * the perfect hash table of the option names, the types of the options,
+     * and the help, all as constants, along with the functions parsing the
+     * values into the members with their type_parser-s.
+     *
+     * \param sch The schema of the parser
+     * \param name The name of the files, the source includes \c name.hxx
+     * \param origin The name of the schema file, noted in the generated files
+     *
+     * \return The sources of the parser
+     */
+    generated_sources
+    emit(const schema& sch, const std::string& name, const std::string& origin);
+}
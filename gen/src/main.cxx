@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * infocli-gen: generates specialized C++ parsers from option schemas,
+ * see the README for the schema format.
+ */
+
+#include <cctype>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <info/cli.hxx>
+
+#include "emit.hxx"
+#include "schema.hxx"
+
+using namespace info::cli::udl;
+
+namespace {
+    /// Writes the file if its contents differ, to not trigger needless rebuilds
+    void
+    write_file(const std::string& path, const std::string& contents) {
+        {
+            std::ifstream in(path, std::ios::binary);
+            std::string old((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            if (in && old == contents) {
+                return;
+            }
+        }
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << contents;
+        if (!out) {
+            throw std::runtime_error(fmt::format("cannot write '{}'", path));
+        }
+    }
+
+    std::string
+    file_name_of(const std::string& path) {
+        return path.substr(path.find_last_of("/\\") + 1);// npos + 1 == 0
+    }
+
+    std::string
+    stem_of(const std::string& path) {
+        auto file = file_name_of(path);
+        return file.substr(0, file.find('.'));
+    }
+
+    std::string
+    identifier_of(std::string name) {
+        for (auto& c : name) {
+            if (!std::isalnum(static_cast<unsigned char>(c))) {
+                c = '_';
+            }
+        }
+        if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front()))) {
+            name.insert(0, "_");
+        }
+        return name;
+    }
+}
+
+int
+main(int argc, char** argv) try {
+    std::string output = ".";
+    std::string name;
+    info::cli::cli_parser cli{
+           'o'_opt / "output" >= "The directory to write the generated files to [.]" >>= output,
+           'n'_opt / "name" >= "The name of the generated files, the stem of the schema by default" >>= name};
+    auto operands = cli["SCHEMA"](argc, argv);
+    if (operands.size() != 2) {
+        fmt::print(stderr, "infocli-gen: error: expected exactly one schema, see --help\n");
+        return 1;
+    }
+
+    std::string schema_path(operands[1]);
+    std::ifstream in(schema_path);
+    if (!in) {
+        fmt::print(stderr, "infocli-gen: error: cannot open '{}'\n", schema_path);
+        return 1;
+    }
+    if (name.empty()) {
+        name = stem_of(schema_path);
+    }
+
+    auto sch = info::cli::gen::read_schema(in, schema_path, identifier_of(name));
+    auto sources = info::cli::gen::emit(sch, name, file_name_of(schema_path));
+    write_file(fmt::format("{}/{}.hxx", output, name), sources.header);
+    write_file(fmt::format("{}/{}.cxx", output, name), sources.source);
+    return 0;
+} catch (const info::cli::gen::schema_error& err) {
+    fmt::print(stderr, "{}\n", err.what());
+    return 1;
+} catch (const std::exception& err) {
+    fmt::print(stderr, "infocli-gen: error: {}\n", err.what());
+    return 1;
+}
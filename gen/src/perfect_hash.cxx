@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements searching for the perfect hash table of the option names
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <info/cli/generated_parser.hxx>
+
+#include "perfect_hash.hxx"
+
+namespace {
+    std::size_t
+    next_power_of_two(std::size_t n) {
+        std::size_t ret = 1;
+        while (ret < n) {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    /// Tries to find a displacement for every bucket, fills the slots if succeeded
+    bool
+    displace(const std::vector<std::uint32_t>& hashes,
+             std::uint32_t bucket_mask,
+             std::uint32_t slot_mask,
+             std::vector<std::uint32_t>& displacements,
+             std::vector<int>& slot_keys) {
+        std::vector<std::vector<std::size_t>> buckets(bucket_mask + 1);
+        for (std::size_t i = 0; i < hashes.size(); ++i) {
+            buckets[hashes[i] & bucket_mask].push_back(i);
+        }
+        std::vector<std::size_t> order(buckets.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::stable_sort(order.begin(), order.end(), [&buckets](std::size_t a, std::size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        constexpr const std::uint32_t max_displacement = 1u << 16;
+
+        displacements.assign(buckets.size(), 0);
+        slot_keys.assign(slot_mask + 1, -1);
+        std::vector<std::uint32_t> slots;
+        for (auto b : order) {
+            const auto& bucket = buckets[b];
+            if (bucket.empty()) {
+                break;// sorted, the rest are empty too
+            }
+
+            bool placed = false;
+            for (std::uint32_t d = 0; d < max_displacement && !placed; ++d) {
+                slots.clear();
+                placed = true;
+                for (auto key : bucket) {
+                    auto slot = info::_cli::generated_slot(hashes[key], d) & slot_mask;
+                    if (slot_keys[slot] != -1
+                        || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                        placed = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+                if (placed) {
+                    displacements[b] = d;
+                    for (std::size_t i = 0; i < bucket.size(); ++i) {
+                        slot_keys[slots[i]] = static_cast<int>(bucket[i]);
+                    }
+                }
+            }
+            if (!placed) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+info::cli::gen::perfect_hash
+info::cli::gen::build_perfect_hash(const std::vector<std::string>& names, const std::vector<int>& ids) {
+    assert(names.size() == ids.size());
+    if (std::unordered_set<std::string>(names.begin(), names.end()).size() != names.size()) {
+        throw std::runtime_error("option names are repeated");
+    }
+
+    // ~4 names a bucket and 80% load, doubling the table if no seed works
+    auto bucket_count = next_power_of_two(std::max<std::size_t>(1, names.size() / 4));
+    auto slot_count = next_power_of_two(std::max<std::size_t>(1, names.size() + names.size() / 4));
+
+    std::vector<std::uint32_t> hashes(names.size());
+    std::vector<std::uint32_t> displacements;
+    std::vector<int> slot_keys;
+    for (int grow = 0; grow < 8; ++grow, slot_count <<= 1) {
+        for (std::uint32_t seed = 0; seed < 64; ++seed) {
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                hashes[i] = info::_cli::generated_hash(names[i], seed);
+            }
+
+            if (!displace(hashes,
+                          static_cast<std::uint32_t>(bucket_count - 1),
+                          static_cast<std::uint32_t>(slot_count - 1),
+                          displacements,
+                          slot_keys)) {
+                continue;
+            }
+
+            perfect_hash ret{seed, std::move(displacements), {}, {}};
+            ret.slot_names.reserve(slot_count);
+            ret.slot_ids.reserve(slot_count);
+            for (auto key : slot_keys) {
+                ret.slot_names.push_back(key == -1 ? std::string{} : names[static_cast<std::size_t>(key)]);
+                ret.slot_ids.push_back(key == -1 ? -1 : ids[static_cast<std::size_t>(key)]);
+            }
+            return ret;
+        }
+    }
+    throw std::runtime_error("cannot build the perfect hash table of the option names");
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * The perfect hash table of the option names of a generated parser.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace info::cli::gen {
+    /**
+     * \brief A perfect hash table of option names
+     *
+     * Built with hash and displace: the names are hashed with
+     * info::_cli::generated_hash into buckets, then, starting with the largest
+     * bucket, each bucket gets a displacement which makes all of its names
+     * land in free slots, as given by info::_cli::generated_slot. A lookup is
+     * then a hash, a displacement load, a mix, and one comparison.
+     */
+    struct perfect_hash {
+        std::uint32_t seed;                      ///< The seed of generated_hash
+        std::vector<std::uint32_t> displacements;///< The displacements of the buckets, a power of two of them
+        std::vector<std::string> slot_names;     ///< The name in each slot, or empty
+        std::vector<int> slot_ids;               ///< The id of the option in each slot, or \c -1
+    };
+
+    /**
+     * \brief Builds the perfect hash table of the names
+     *
+     * \throws std::runtime_error if the table cannot be built, eg. names are repeated
+     *
+     * \param names The names to put in the table
+     * \param ids The id of the option of each name
+     *
+     * \return The perfect hash table
+     */
+    perfect_hash
+    build_perfect_hash(const std::vector<std::string>& names, const std::vector<int>& ids);
+}
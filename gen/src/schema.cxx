@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements reading the option schema of infocli-gen
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+#include "schema.hxx"
+
+namespace {
+    std::string_view
+    trim(std::string_view str) {
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front()))) {
+            str.remove_prefix(1);
+        }
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back()))) {
+            str.remove_suffix(1);
+        }
+        return str;
+    }
+
+    std::string_view
+    next_word(std::string_view& line) {
+        line = trim(line);
+        auto end = std::find_if(line.begin(), line.end(), [](unsigned char c) {
+            return std::isspace(c) != 0;
+        });
+        auto word = line.substr(0, static_cast<std::size_t>(end - line.begin()));
+        line.remove_prefix(word.size());
+        return word;
+    }
+
+    bool
+    is_identifier(std::string_view str, bool qualified) {
+        if (str.empty()
+            || std::isdigit(static_cast<unsigned char>(str.front()))) {
+            return false;
+        }
+        for (std::size_t i = 0; i < str.size(); ++i) {
+            auto c = static_cast<unsigned char>(str[i]);
+            if (std::isalnum(c) || c == '_') {
+                continue;
+            }
+            if (qualified && str.substr(i, 2) == "::"
+                && i + 2 < str.size()) {
+                ++i;
+                continue;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    /// Returns the length of the string literal at the start of the string, or 0 if it is not terminated
+    std::size_t
+    literal_length(std::string_view str) {
+        for (std::size_t i = 1; i < str.size(); ++i) {
+            if (str[i] == '\\') {
+                ++i;
+            } else if (str[i] == '"') {
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    std::string_view
+    strip_comment(std::string_view line) {
+        bool in_literal = false;
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            if (in_literal && line[i] == '\\') {
+                ++i;
+            } else if (line[i] == '"') {
+                in_literal = !in_literal;
+            } else if (!in_literal && line[i] == '#') {
+                return line.substr(0, i);
+            }
+        }
+        return line;
+    }
+}
+
+info::cli::gen::schema
+info::cli::gen::read_schema(std::istream& in, const std::string& file, const std::string& default_struct) {
+    schema ret{default_struct, {}, {}, {}};
+    std::unordered_set<std::string> names;
+    std::unordered_set<std::string> fields;
+
+    std::string buffer;
+    for (std::size_t line_no = 1; std::getline(in, buffer); ++line_no) {
+        auto error = [&](std::string_view msg) {
+            return schema_error(fmt::format("{}:{}: error: {}", file, line_no, msg));
+        };
+
+        auto line = trim(strip_comment(buffer));
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line.front() == '%') {
+            line.remove_prefix(1);
+            auto directive = next_word(line);
+            auto arg = trim(line);
+            if (directive == "struct") {
+                if (!is_identifier(arg, false)) {
+                    throw error(fmt::format("'{}' is not a valid struct name", arg));
+                }
+                ret.struct_name = arg;
+            } else if (directive == "namespace") {
+                if (!is_identifier(arg, true)) {
+                    throw error(fmt::format("'{}' is not a valid namespace", arg));
+                }
+                ret.namespace_name = arg;
+            } else if (directive == "include") {
+                if (arg.size() < 3
+                    || !((arg.front() == '<' && arg.back() == '>')
+                         || (arg.front() == '"' && arg.back() == '"'))) {
+                    throw error(fmt::format("'{}' is not an include, use <header> or \"header\"", arg));
+                }
+                ret.includes.emplace_back(arg);
+            } else {
+                throw error(fmt::format("unknown directive '%{}'", directive));
+            }
+            continue;
+        }
+
+        schema_option opt;
+        opt.field = next_word(line);
+        if (!is_identifier(opt.field, false)) {
+            throw error(fmt::format("'{}' is not a valid field name", opt.field));
+        }
+        if (!fields.insert(opt.field).second) {
+            throw error(fmt::format("field '{}' is defined more than once", opt.field));
+        }
+
+        auto name_list = next_word(line);
+        if (name_list.empty()) {
+            throw error(fmt::format("option '{}' has no names", opt.field));
+        }
+        for (std::size_t pos = 0; pos != std::string_view::npos;) {
+            auto bar = name_list.find('|', pos);
+            auto name = name_list.substr(pos, bar == std::string_view::npos ? bar : bar - pos);
+            pos = bar == std::string_view::npos ? bar : bar + 1;
+
+            if (name.empty() || name.front() == '-'
+                || name.find('=') != std::string_view::npos) {
+                throw error(fmt::format("'{}' is not a valid option name", name));
+            }
+            if (!names.emplace(name).second) {
+                throw error(fmt::format("option name '{}' is used more than once", name));
+            }
+            opt.names.emplace_back(name);
+        }
+
+        auto help_at = line.find('"');
+        if (help_at != std::string_view::npos) {
+            auto help = line.substr(help_at);
+            auto length = literal_length(help);
+            if (length == 0) {
+                throw error("unterminated help text");
+            }
+            if (!trim(help.substr(length)).empty()) {
+                throw error("unexpected text after the help text");
+            }
+            opt.help = help.substr(0, length);
+            line = line.substr(0, help_at);
+        }
+
+        auto eq = line.find('=');
+        if (eq != std::string_view::npos) {
+            opt.init = trim(line.substr(eq + 1));
+            if (opt.init.empty()) {
+                throw error(fmt::format("option '{}' has an empty initializer", opt.field));
+            }
+            line = line.substr(0, eq);
+        }
+
+        opt.type = trim(line);
+        if (opt.type.empty()) {
+            throw error(fmt::format("option '{}' has no type", opt.field));
+        }
+        ret.options.push_back(std::move(opt));
+    }
+
+    if (!is_identifier(ret.struct_name, false)) {
+        throw schema_error(fmt::format("{}: error: '{}' is not a valid struct name, set one with %struct",
+                                       file,
+                                       ret.struct_name));
+    }
+    if (ret.options.empty()) {
+        throw schema_error(fmt::format("{}: error: the schema defines no options", file));
+    }
+    return ret;
+}
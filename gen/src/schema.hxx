@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * The option schema read by infocli-gen.
+ */
+#pragma once
+
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace info::cli::gen {
+    /**
+     * \brief An error in the schema, reported with its location
+     */
+    struct schema_error : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * \brief An option of the schema
+     */
+    struct schema_option {
+        std::string field;             ///< The name of the member the value is stored in
+        std::vector<std::string> names;///< The names of the option, without dashes
+        std::string type;              ///< The C++ type of the option, possibly a type modifier
+        std::string init;              ///< The initializer of the member, or empty
+        std::string help;              ///< The help as a C++ string literal with the quotes, or empty
+    };
+
+    /**
+     * \brief The option schema of a generated parser
+     *
+     * The schema is line based, \c # starts a comment. Directives start with
+     * \c %, the others lines define an option each:
+     *
+     * \verbatim
+     * %struct options            # the name of the generated struct
+     * %namespace app::cli        # the namespace of the generated struct
+     * %include <filesystem>      # an include needed by the types
+     *
+     * # field   names           type          [= init]   ["help"]
+     * verbose   v|verbose       bool                     "Print more"
+     * jobs      j|jobs          unsigned      = 1        "The number of jobs"
+     * inputs    i|input         std::vector<std::string>
+     * \endverbatim
+     */
+    struct schema {
+        std::string struct_name;          ///< The name of the generated struct
+        std::string namespace_name;       ///< The namespace of the generated struct, or empty
+        std::vector<std::string> includes;///< The extra includes of the generated header, with the brackets
+        std::vector<schema_option> options;///< The options, in order of definition
+    };
+
+    /**
+     * \brief Reads a schema
+     *
+     * \throws schema_error if the schema is malformed, with the message
+     *         <tt>file:line: error: description</tt>
+     *
+     * \param in The stream to read the schema from
+     * \param file The name of the schema file, for errors
+     * \param default_struct The name of the struct if the schema does not give one
+     *
+     * \return The schema read
+     */
+    schema
+    read_schema(std::istream& in, const std::string& file, const std::string& default_struct);
+}
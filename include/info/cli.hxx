@@ -6,8 +6,15 @@
  */
 #pragma once
 
+#include <info/cli/batch_parser.hxx>
+#include <info/cli/buffer_parser.hxx>
 #include <info/cli/cli_parser.hxx>
+#include <info/cli/config_source.hxx>
+#include <info/cli/constraint.hxx>
+#include <info/cli/fixed_cli_parser.hxx>
 #include <info/cli/option.hxx>
+#include <info/cli/push_parser.hxx>
+#include <info/cli/snapshot.hxx>
 
 /**
  * \brief Main namespace of the InfoCLI library
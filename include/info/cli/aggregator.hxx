@@ -31,13 +31,22 @@
 #pragma once
 
 // stdlib
+#include <cstddef>
 #include <deque>
 #include <list>
+#include <map>
 #include <queue>
+#include <set>
 #include <stack>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include <info/cli/extra/lazy.hxx>
+#include <info/cli/extra/on_duplicate.hxx>
 #include <info/cli/extra/repeat.hxx>
 #include <info/cli/macros.hxx>
 
@@ -55,10 +64,27 @@ namespace info::_cli {
      * \tparam T The type to aggregate on
      */
     template<class T>
-    struct INFO_CLI_API aggregator_ : std::false_type {
+    struct aggregator_ : std::false_type {
         using type = T;///< The type aggregated on
     };
 
+    /**
+     * \brief Checks if the aggregator of T can reserve room for the values ahead
+     *
+     * An aggregator is reservable if it has a \c reservable member set to true,
+     * in which case it also has a \c reserve(cont, n) member function, which
+     * makes room for n more values in the aggregated object.
+     *
+     * \tparam T The type to aggregate on
+     */
+    template<class T, class = void>
+    struct is_reservable_ : std::false_type { };
+
+    /// \copydoc is_reservable_
+    template<class T>
+    struct is_reservable_<T, std::void_t<decltype(aggregator_<T>::reservable)>>
+         : std::bool_constant<aggregator_<T>::reservable> { };
+
     /**
      * \copybrief aggregator_
      *
@@ -70,8 +96,21 @@ namespace info::_cli {
      * \tparam T The modified type
      */
     template<class T>
-    struct INFO_CLI_API aggregator_<cli::repeat<T>> : std::true_type {
+    struct aggregator_<cli::repeat<T>> : std::true_type {
         using type = T;///< The modified type
+        /// Integral types are incremented, others reserve like their own aggregator
+        constexpr static bool reservable = !std::is_integral_v<T> && is_reservable_<T>::value;
+
+        /**
+         * \brief Makes room for n more values in the modified type's lvalue reference
+         *
+         * \param rep The lvalue reference to the wrapped type
+         * \param n The amount of values which will be aggregated into it
+         */
+        void
+        reserve(T& rep, std::size_t n) const {
+            aggregator_<T>{}.reserve(rep, n);
+        }
 
         /**
          * \brief Performs aggregation on a modified type's extracted lvalue reference
@@ -116,8 +155,20 @@ namespace info::_cli {
      * \tparam T The contained type of the vector
      */
     template<class T>
-    struct INFO_CLI_API aggregator_<std::vector<T>> : std::true_type {
+    struct aggregator_<std::vector<T>> : std::true_type {
         using type = T;///< The contained type
+        constexpr static bool reservable = true;///< Vectors can be reserved
+
+        /**
+         * \brief Makes room for n more elements in the vector
+         *
+         * \param cont The vector to reserve
+         * \param n The amount of elements which will be added to the vector
+         */
+        void
+        reserve(std::vector<T>& cont, std::size_t n) const {
+            cont.reserve(cont.size() + n);
+        }
 
         /**
          * \brief Aggregates the given vector
@@ -150,7 +201,7 @@ namespace info::_cli {
      * \tparam T The contained type of the list
      */
     template<class T>
-    struct INFO_CLI_API aggregator_<std::list<T>> : std::true_type {
+    struct aggregator_<std::list<T>> : std::true_type {
         using type = T;///< The contained type
 
         /**
@@ -185,7 +236,7 @@ namespace info::_cli {
      * \tparam T The contained type of the stack
      */
     template<class T>
-    struct INFO_CLI_API aggregator_<std::stack<T>> : std::true_type {
+    struct aggregator_<std::stack<T>> : std::true_type {
         using type = T;///< The contained type
 
         /**
@@ -220,7 +271,7 @@ namespace info::_cli {
      * \tparam T The contained type of the queue
      */
     template<class T>
-    struct INFO_CLI_API aggregator_<std::queue<T>> : std::true_type {
+    struct aggregator_<std::queue<T>> : std::true_type {
         using type = T;///< The contained type
 
         /**
@@ -255,7 +306,7 @@ namespace info::_cli {
      * \tparam T The contained type of the deque
      */
     template<class T>
-    struct INFO_CLI_API aggregator_<std::deque<T>> : std::true_type {
+    struct aggregator_<std::deque<T>> : std::true_type {
         using type = T;///< The contained type
 
         /**
@@ -280,6 +331,297 @@ namespace info::_cli {
         }
     };
 
+    /**
+     * \brief Inserts a key-value pair into a map-like container
+     *
+     * Emplaces the pair into the container, handling an already present key
+     * as described by the policy.
+     *
+     * \param cont The map to insert into
+     * \param elem The parsed key and value
+     * \param policy What to do if the key is already present
+     *
+     * \return Whether the insertion is accepted by the policy
+     */
+    template<class C, class K, class V>
+    bool
+    insert_keyed(C& cont, std::pair<K, V>&& elem, cli::duplicate_key policy) {
+        auto [it, inserted] = cont.try_emplace(std::move(elem.first), std::move(elem.second));
+        if (inserted) {
+            return true;
+        }
+        switch (policy) {
+        case cli::duplicate_key::overwrite:
+            it->second = std::move(elem.second);
+            return true;
+        case cli::duplicate_key::keep_first:
+            return true;
+        case cli::duplicate_key::reject:
+            return false;
+        }
+        return false;
+    }
+
+    /**
+     * \brief Inserts a key into a set-like container
+     *
+     * Keys in sets have no value to overwrite, so \c overwrite and \c keep_first
+     * behave the same.
+     *
+     * \param cont The set to insert into
+     * \param elem The parsed key
+     * \param policy What to do if the key is already present
+     *
+     * \return Whether the insertion is accepted by the policy
+     */
+    template<class C, class K>
+    bool
+    insert_key(C& cont, K&& elem, cli::duplicate_key policy) {
+        return cont.emplace(std::forward<K>(elem)).second
+               || policy != cli::duplicate_key::reject;
+    }
+
+    /**
+     * \copybrief aggregator_
+     *
+     * Aggregator that aggregates maps of K to V. The parsed type is
+     * a `KEY=VALUE` pair, whose key and value are parsed by their own
+     * type_parsers.
+     *
+     * \tparam K The key type of the map
+     * \tparam V The mapped type of the map
+     */
+    template<class K, class V, class... Rest>
+    struct aggregator_<std::map<K, V, Rest...>> : std::true_type {
+        using type = std::pair<K, V>;///< The parsed key-value pair
+
+        /**
+         * \brief Aggregates the given map
+         *
+         * \param cont The map to insert into
+         * \param elem The key-value pair to insert
+         * \param policy What to do if the key is already present
+         *
+         * \return Whether the insertion is accepted by the policy
+         */
+        bool
+        operator()(std::map<K, V, Rest...>& cont,
+                   std::pair<K, V>&& elem,
+                   cli::duplicate_key policy = cli::duplicate_key::overwrite) const {
+            return insert_keyed(cont, std::move(elem), policy);
+        }
+    };
+
+    /**
+     * \copybrief aggregator_
+     *
+     * Aggregator that aggregates unordered_maps of K to V. The parsed type is
+     * a `KEY=VALUE` pair, whose key and value are parsed by their own
+     * type_parsers.
+     *
+     * \tparam K The key type of the map
+     * \tparam V The mapped type of the map
+     */
+    template<class K, class V, class... Rest>
+    struct aggregator_<std::unordered_map<K, V, Rest...>> : std::true_type {
+        using type = std::pair<K, V>;           ///< The parsed key-value pair
+        constexpr static bool reservable = true;///< Hash tables can be reserved
+
+        /**
+         * \brief Aggregates the given unordered_map
+         *
+         * \param cont The map to insert into
+         * \param elem The key-value pair to insert
+         * \param policy What to do if the key is already present
+         *
+         * \return Whether the insertion is accepted by the policy
+         */
+        bool
+        operator()(std::unordered_map<K, V, Rest...>& cont,
+                   std::pair<K, V>&& elem,
+                   cli::duplicate_key policy = cli::duplicate_key::overwrite) const {
+            return insert_keyed(cont, std::move(elem), policy);
+        }
+
+        /**
+         * \brief Makes room for n more elements in the map
+         *
+         * \param cont The map to reserve
+         * \param n The amount of elements which will be added to the map
+         */
+        void
+        reserve(std::unordered_map<K, V, Rest...>& cont, std::size_t n) const {
+            cont.reserve(cont.size() + n);
+        }
+    };
+
+    /**
+     * \copybrief aggregator_
+     *
+     * Aggregator that aggregates sets of type T.
+     *
+     * \tparam T The key type of the set
+     */
+    template<class T, class... Rest>
+    struct aggregator_<std::set<T, Rest...>> : std::true_type {
+        using type = T;///< The contained type
+
+        /**
+         * \brief Aggregates the given set
+         *
+         * \tparam U Type of the element to be added
+         *
+         * \param cont The set to insert into
+         * \param elem The key to insert
+         * \param policy What to do if the key is already present
+         *
+         * \return Whether the insertion is accepted by the policy
+         */
+        template<class U>
+        bool
+        operator()(std::set<T, Rest...>& cont,
+                   U&& elem,
+                   cli::duplicate_key policy = cli::duplicate_key::overwrite) const {
+            return insert_key(cont, std::forward<U>(elem), policy);
+        }
+    };
+
+    /**
+     * \copybrief aggregator_
+     *
+     * Aggregator that aggregates unordered_sets of type T.
+     *
+     * \tparam T The key type of the set
+     */
+    template<class T, class... Rest>
+    struct aggregator_<std::unordered_set<T, Rest...>> : std::true_type {
+        using type = T;                         ///< The contained type
+        constexpr static bool reservable = true;///< Hash tables can be reserved
+
+        /**
+         * \brief Aggregates the given unordered_set
+         *
+         * \tparam U Type of the element to be added
+         *
+         * \param cont The set to insert into
+         * \param elem The key to insert
+         * \param policy What to do if the key is already present
+         *
+         * \return Whether the insertion is accepted by the policy
+         */
+        template<class U>
+        bool
+        operator()(std::unordered_set<T, Rest...>& cont,
+                   U&& elem,
+                   cli::duplicate_key policy = cli::duplicate_key::overwrite) const {
+            return insert_key(cont, std::forward<U>(elem), policy);
+        }
+
+        /**
+         * \brief Makes room for n more elements in the set
+         *
+         * \param cont The set to reserve
+         * \param n The amount of elements which will be added to the set
+         */
+        void
+        reserve(std::unordered_set<T, Rest...>& cont, std::size_t n) const {
+            cont.reserve(cont.size() + n);
+        }
+    };
+
+    /**
+     * \copybrief aggregator_
+     *
+     * Defines the handling of the on_duplicate type modifier: the wrapped
+     * associative container is aggregated by its own aggregator, with the
+     * policy given to the modifier.
+     *
+     * \tparam Policy The duplicate_key policy to use
+     * \tparam T The modified associative container type
+     */
+    template<cli::duplicate_key Policy, class T>
+    struct aggregator_<cli::on_duplicate_<Policy, T>> : std::true_type {
+        using type = typename aggregator_<T>::type;                ///< The type parsed for the container
+        constexpr static bool reservable = is_reservable_<T>::value;///< Reservable if the container is
+
+        /**
+         * \brief Aggregates into the modified type's extracted lvalue reference
+         *
+         * \tparam U The type of the value to be aggregated into the lvalue reference
+         *
+         * \param cont The lvalue reference to the wrapped container
+         * \param elem The forwarding reference to aggregate into \c cont
+         *
+         * \return Whether the insertion is accepted by the policy
+         */
+        template<class U>
+        bool
+        operator()(T& cont, U&& elem) const {
+            return aggregator_<T>{}(cont, std::forward<U>(elem), Policy);
+        }
+
+        /**
+         * \brief Makes room for n more elements in the wrapped container
+         *
+         * \param cont The lvalue reference to the wrapped container
+         * \param n The amount of elements which will be added to it
+         */
+        void
+        reserve(T& cont, std::size_t n) const {
+            aggregator_<T>{}.reserve(cont, n);
+        }
+    };
+
+    /**
+     * \copybrief aggregator_
+     *
+     * Defines the handling of the lazy type modifier: the value is not parsed,
+     * only its view is recorded in the lazy object. Whether the earlier values
+     * are kept depends on whether the wrapped type is aggregating.
+     *
+     * \tparam T The type of the lazy value
+     */
+    template<class T>
+    struct aggregator_<cli::lazy<T>> : std::true_type {
+        using type = std::string_view;///< The value is kept as found on the command line
+
+        /**
+         * \brief Records the unparsed value in the lazy object
+         *
+         * \param value The lazy object to record the value in
+         * \param source The value as found on the command line
+         */
+        void
+        operator()(cli::lazy<T>& value, std::string_view source) const {
+            value.add_source(source, aggregator_<T>::value);
+        }
+    };
+
+    /**
+     * \brief Aggregates the element into the reference by the aggregator of type \c T
+     *
+     * Aggregators either return void, which always succeed, or bool,
+     * which is false if the element was refused.
+     *
+     * \tparam T The type to perform the aggregating functions on
+     *
+     * \param ref The reference to aggregate into
+     * \param elem The element to aggregate
+     *
+     * \return Whether the aggregation succeeded
+     */
+    template<class T, class R, class U>
+    bool
+    aggregate(R& ref, U&& elem) {
+        constexpr auto agg = aggregator_<T>{};
+        if constexpr (std::is_void_v<decltype(agg(ref, std::forward<U>(elem)))>) {
+            agg(ref, std::forward<U>(elem));
+            return true;
+        } else {
+            return agg(ref, std::forward<U>(elem));
+        }
+    }
+
     /**
      * \brief Instance of an aggregator for type \c T
      *
@@ -288,6 +630,14 @@ namespace info::_cli {
     template<class T>
     INFO_CLI_LOCAL constexpr static auto aggregator = aggregator_<T>{};
 
+    /**
+     * \brief Whether the aggregator for type \c T can reserve room ahead
+     *
+     * \tparam T The type to aggregate on
+     */
+    template<class T>
+    constexpr static bool is_reservable = is_reservable_<T>::value;
+
     /**
      * \brief Meta-function to get the type the aggregator type is aggregating on
      *
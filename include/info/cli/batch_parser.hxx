@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines batch_parser, which parses many command lines on multiple threads
+ * into a column of values for every option.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/macros.hxx>
+#include <info/cli/option.hxx>
+
+namespace info::cli {
+    /**
+     * \brief The values of an option in every command line of a batch
+     *
+     * \tparam T The type of the values, which are parsed by type_parser<T>
+     */
+    template<class T>
+    struct column {
+        std::vector<T> values;            ///< The value of each line; value-initialized where the option was not given
+        std::vector<std::uint64_t> present;///< The bit set of the lines the option was given in
+
+        /**
+         * \brief Whether the option was given in the line
+         *
+         * \param line The index of the line in the batch
+         *
+         * \return Whether the option was given in the line
+         */
+        [[nodiscard]] bool
+        given(std::size_t line) const noexcept {
+            return (present[line / 64] >> line % 64 & 1) != 0;
+        }
+    };
+
+    /**
+     * \brief The operands of every command line of a batch, one after the other
+     *
+     * The operands of the line \c i are the ones from <tt>values[offsets[i]]</tt>
+     * up to <tt>values[offsets[i + 1]]</tt>, thus \c offsets has one more
+     * element than there are lines. Lines which could not be parsed have no
+     * operands.
+     */
+    struct INFO_CLI_API operand_column {
+        std::vector<std::string_view> values;///< The operands of the lines, viewing the lines
+        std::vector<std::size_t> offsets;    ///< The index of the first operand of each line, and the end
+    };
+
+    /**
+     * \brief A command line of a batch which could not be parsed
+     */
+    struct INFO_CLI_API batch_error {
+        std::size_t line;   ///< The index of the line in the batch
+        std::string message;///< The message of the exception the parsing threw
+    };
+}
+
+namespace info::_cli {
+    /**
+     * \brief The value of a column being parsed on a thread
+     *
+     * Each thread parses the values of its current line into cells, which
+     * are only stored into the column when the line was parsed, so lines
+     * failing halfway through leave their columns unset.
+     */
+    struct INFO_CLI_API batch_cell {
+        virtual ~batch_cell() = default;
+
+        bool touched = false;///< Whether the option was given in the current line
+
+        /// Parses the value into the cell, as the callback of the option would
+        virtual bool parse(std::string_view value, const char*& last) = 0;
+        /// Moves the value into the line of the column, and resets the cell
+        virtual void store(std::size_t line) = 0;
+        /// Resets the cell, dropping its value
+        virtual void discard() = 0;
+    };
+
+    /// The type-erased owner of a column of a batch_parser
+    struct INFO_CLI_API batch_column {
+        virtual ~batch_column() = default;
+
+        /// Makes room for the lines, dropping the values of the last batch
+        virtual void resize(std::size_t lines) = 0;
+        /// Creates a cell of the column for a thread
+        [[nodiscard]] virtual std::unique_ptr<batch_cell> cell() = 0;
+    };
+
+    template<class T>
+    struct batch_cell_of final : batch_cell {
+        explicit batch_cell_of(cli::column<T>& column)
+             : _column(column) { }
+
+        bool
+        parse(std::string_view value, const char*& last) override {
+            return _callback(value, last);
+        }
+
+        void
+        store(std::size_t line) override {
+            // the threads own whole words of the bit set, and of std::vector<bool>
+            _column.values[line] = std::move(_value);
+            _column.present[line / 64] |= std::uint64_t{1} << line % 64;
+            discard();
+        }
+
+        void
+        discard() override {
+            _value = T{};
+            touched = false;
+        }
+
+    private:
+        cli::column<T>& _column;
+        T _value{};
+        std::function<cli::option::callback_type> _callback = cli::make_callback(_value);
+    };
+
+    template<class T>
+    struct batch_column_of final : batch_column {
+        cli::column<T> column;
+
+        void
+        resize(std::size_t lines) override {
+            column.values.assign(lines, T{});
+            column.present.assign((lines + 63) / 64, 0);
+        }
+
+        [[nodiscard]] std::unique_ptr<batch_cell>
+        cell() override {
+            return std::make_unique<batch_cell_of<T>>(column);
+        }
+    };
+}
+
+namespace info::cli {
+    /**
+     * \brief Parses many command lines on multiple threads into columns
+     *
+     * Takes the options of a cli_parser as its schema, and parses each
+     * command line with them, by the same rules as the cli_parser. Instead
+     * of calling the callbacks of the schema, the values of the options
+     * are parsed with type_parser<T> into columns, which are added for the
+     * options whose values are needed; the values of the other options are
+     * skipped. The operands of every line are collected into one
+     * operand_column, and the lines which could not be parsed are reported
+     * as batch_errors, without stopping the rest of the batch.
+     *
+     * The lines are NUL-separated buffers, as parsed by buffer_parser, the
+     * first argument being the program name. They are handed out to the
+     * threads in blocks, and every thread parses its blocks with its own
+     * parser loaded from a snapshot of the schema, writing different words
+     * of the columns, so the threads share nothing while parsing.
+     *
+     * \verbatim
+     * cli::batch_parser batch(schema);
+     * const auto& jobs = batch.add_column<int>("jobs");
+     * batch(lines);
+     * for (std::size_t i = 0; i < lines.size(); ++i) {
+     *     if (jobs.given(i)) {
+     *         histogram[jobs.values[i]]++;
+     *     }
+     * }
+     * \endverbatim
+     *
+     * \note The constraints and validators of the schema are not checked,
+     * and the Auto-Help is not printed, \c \-\-help is skipped like the
+     * options without columns. Options in the schema must not have operand
+     * slots, the same as for snapshots.
+     */
+    class INFO_CLI_API batch_parser {
+    public:
+        /**
+         * \brief Creates the batch parser for the options of the schema
+         *
+         * \throws std::logic_error if the schema has operand slots
+         *
+         * \param schema The parser whose options are parsed; only used during construction
+         */
+        explicit batch_parser(const cli_parser& schema);
+
+        batch_parser(const batch_parser&) = delete;
+        batch_parser& operator=(const batch_parser&) = delete;
+
+        /// Frees the columns
+        ~batch_parser();
+
+        /**
+         * \brief Adds a column for the values of the option
+         *
+         * \throws std::invalid_argument if the option is not in the schema,
+         * or it already has a column
+         *
+         * \tparam T The type of the values, which should be the type of the option's callback
+         *
+         * \param name Any name of the option, without dashes
+         *
+         * \return The column, filled by every call of the batch parser
+         */
+        template<class T>
+        const column<T>&
+        add_column(std::string_view name) {
+            auto owner = std::make_unique<_cli::batch_column_of<T>>();
+            auto& ret = owner->column;
+            add_column(name, std::move(owner));
+            return ret;
+        }
+
+        /**
+         * \brief Parses the lines into the columns
+         *
+         * Replaces the contents of every column, the operands, and the errors
+         * with the ones of the lines.
+         *
+         * \warning The operands view the lines, so they are only valid while
+         * the lines are alive.
+         *
+         * \param lines The command lines, as NUL-separated buffers
+         */
+        void operator()(const std::vector<std::string_view>& lines);
+
+        /**
+         * Sets how many threads parse the lines.
+         *
+         * Unless changed, or set to 0, it is the amount of hardware threads.
+         * Never more threads are started than there are blocks of lines.
+         *
+         * \param threads The maximal amount of threads to use
+         */
+        void
+        threads(std::size_t threads) noexcept {
+            _threads = threads;
+        }
+
+        /**
+         * \brief Returns the operands of the lines parsed last
+         *
+         * \return The operands of every line
+         */
+        [[nodiscard]] const operand_column&
+        operands() const noexcept {
+            return _operands;
+        }
+
+        /**
+         * \brief Returns the lines of the last batch which could not be parsed
+         *
+         * \return The errors, in order of the lines
+         */
+        [[nodiscard]] const std::vector<batch_error>&
+        errors() const noexcept {
+            return _errors;
+        }
+
+    private:
+        /// What is needed to skip the value of an option without a column
+        struct skipped_type {
+            parse_type expected_type;
+            int length;
+        };
+
+        std::string _snapshot;                                  ///< The schema, the threads load their parsers from
+        std::vector<skipped_type> _types;                       ///< The types of the options, by id
+        std::vector<std::unique_ptr<_cli::batch_column>> _columns;///< The columns of the options, by id; null if none
+        std::unordered_map<std::string, std::size_t> _ids;      ///< The ids of the options, by every name
+        enum unknown_behavior _unknown;
+        std::size_t _threads = 0;
+        operand_column _operands;
+        std::vector<batch_error> _errors;
+
+        /// Adds the column to the option with the name
+        void add_column(std::string_view name, std::unique_ptr<_cli::batch_column> column);
+    };
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../src/batch_parser.cxx"
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines buffer_parser, which parses many command lines stored as
+ * NUL-separated buffers with one cli_parser, reusing its storage.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/macros.hxx>
+
+namespace info::cli {
+    /**
+     * \brief Parses command lines stored as NUL-separated buffers, reusing its storage
+     *
+     * Each buffer is a whole command line, every argument terminated by
+     * a NUL character, like <tt>/proc/&lt;pid&gt;/cmdline</tt> on Linux,
+     * and is parsed the same way as by cli_parser::operator()(std::string_view).
+     * The array of pointers to the arguments, and the vector of the
+     * operands are kept between the calls, so once they grew to fit the
+     * longest command line, parsing does not allocate, unless the callbacks
+     * do, an exception is thrown, or the Auto-Help is printed.
+     *
+     * \verbatim
+     * cli::buffer_parser parse(cli);
+     * for (const auto& cmdline : cmdlines) {
+     *     for (auto op : parse(cmdline)) {
+     *         process(op);
+     *     }
+     * }
+     * \endverbatim
+     *
+     * \note The cli_parser may only be used by one parse at a time.
+     */
+    class INFO_CLI_API buffer_parser {
+    public:
+        /**
+         * \brief Creates the parser of buffers with the given parser
+         *
+         * \param parser The parser whose options are parsed; must outlive the buffer_parser
+         */
+        explicit buffer_parser(cli_parser& parser) noexcept;
+
+        /**
+         * \brief Parses the NUL-separated arguments of the buffer
+         *
+         * \warning The returned operands view the buffer, and are overwritten
+         * by the next call. If the last argument is not terminated, it is
+         * copied, and the values given to the callbacks for it are only valid
+         * during the call.
+         *
+         * \throws Anything cli_parser::operator() throws for the arguments
+         *
+         * \param args The arguments, each terminated by a NUL character
+         *
+         * \return The operands in order of encounter, valid until the next call
+         */
+        const std::vector<std::string_view>& operator()(std::string_view args);
+
+    private:
+        cli_parser& _parser;
+        std::vector<char*> _argv;///< The pointers to the arguments of the buffer
+        std::vector<std::string_view> _operands;
+        std::string _last;///< The copy of the last argument, if it is not terminated
+    };
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../src/buffer_parser.cxx"
+#endif
@@ -7,14 +7,22 @@
  */
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <info/cli/constraint.hxx>
 #include <info/cli/macros.hxx>
 #include <info/cli/option.hxx>
 #include <info/cli/types/type_data.hxx>
@@ -32,14 +40,15 @@ namespace info::_cli {
      */
     template<class Callback>
     struct INFO_CLI_LOCAL help_text {
-        std::string help_msg;           ///< The help message
-        std::vector<Callback> callbacks;///< The vector of callbacks the help message applies to
+        std::string_view help_msg;           ///< The help message, viewing the parser's string pool
+        std::pmr::vector<Callback> callbacks;///< The vector of callbacks the help message applies to
 
         /**
          * \brief Constructs a help_text object for use
          *
-         * Takes the help message and the moves vector of callbacks associated
-         * with that message into the newly constructed object.
+         * Refers to the help message, which must outlive the object, and moves
+         * the vector of callbacks associated with that message into the newly
+         * constructed object.
          *
          * A callback in this context are the whole option descriptors,
          * which are referred back to the help message stored here.
@@ -47,9 +56,9 @@ namespace info::_cli {
          * \param help_msg The message applied to the callbacks
          * \param callbacks A vector of callbacks which share one help description
          */
-        help_text(std::string help_msg,
-                  std::vector<Callback>&& callbacks)
-             : help_msg(std::move(help_msg)),
+        help_text(std::string_view help_msg,
+                  std::pmr::vector<Callback>&& callbacks)
+             : help_msg(help_msg),
                callbacks(std::move(callbacks)) { }
 
         /**
@@ -90,11 +99,34 @@ namespace std {
          */
         std::size_t
         operator()(const info::_cli::help_text<Callback>& txt) const {
-            return ::std::hash<std::string>{}(txt.help_msg);
+            return ::std::hash<std::string_view>{}(txt.help_msg);
         }
     };
 }
 
+namespace info::_cli {
+    /**
+     * \brief Hashes option names ignoring their case, dashes, and underscores
+     *
+     * The hash of the names name_matching::folded matches to each other is
+     * the same. The characters are folded while hashing, so the name is not
+     * copied.
+     */
+    struct INFO_CLI_LOCAL folded_hash {
+        std::size_t operator()(std::string_view name) const noexcept;
+    };
+
+    /**
+     * \brief Compares option names ignoring their case, dashes, and underscores
+     *
+     * Walks the two names together, skipping the separators and comparing
+     * the ASCII lowercase of the other characters, so neither is copied.
+     */
+    struct INFO_CLI_LOCAL folded_equal {
+        bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+    };
+}
+
 namespace info::cli {
     /**
      * An enumeration showing how an invalid option can be handled.
@@ -106,6 +138,54 @@ namespace info::cli {
         pass_back ///< Put unknown option into the operands set as-is
     };
 
+    /**
+     * An enumeration of the ways the names of long options are matched to the
+     * registered ones. Short options are always matched exactly.
+     */
+    enum class name_matching {
+        exact, ///< The default; the name must be spelled as it was registered
+        folded ///< Case, dashes, and underscores are ignored, so --Output-Dir, --output_dir, and --outputdir are the same
+    };
+
+    /**
+     * The ways cli_parser::forward decides where parsing stops, after which
+     * every argument is forwarded as-is.
+     */
+    enum class forwarding {
+        interleaved,///< The default; options are parsed up to \c \-\-, wherever they are among the forwarded arguments
+        posix       ///< Parsing also stops at the first operand, like getopt with \c POSIXLY_CORRECT set
+    };
+
+    /**
+     * The shells for which a static completion script can be generated by
+     * cli_parser::completion_script.
+     */
+    enum class shell {
+        bash,///< GNU Bash, registered with \c complete \c -F
+        zsh, ///< Z shell, using the \c _arguments completion function
+        fish ///< fish, with one \c complete command per option
+    };
+
+    /**
+     * \brief Tag type for constructing a cli_parser from a snapshot
+     *
+     * Used to select the cli_parser constructor which loads a parser
+     * from a snapshot created by cli_parser::snapshot.
+     */
+    struct from_snapshot_t {
+        explicit from_snapshot_t() = default;
+    };
+
+    /**
+     * \brief The tag for constructing a cli_parser from a snapshot
+     */
+    inline constexpr from_snapshot_t from_snapshot{};
+
+    class push_parser;
+    class buffer_parser;
+    class batch_parser;
+    class config_source;
+
     /**
      * \brief Handles the parsing of command line arguments and calling of callbacks
      *
@@ -125,7 +205,15 @@ namespace info::cli {
      * options found.
      *
      * Operands are collected and returned after the option handling finishes,
-     * or if the operand \c \-\- is encountered.
+     * or if the operand \c \-\- is encountered. Operands may instead be
+     * parsed into typed variables during the same walk, by giving the
+     * parser operand slots, see cli::operand and cli::operands.
+     *
+     * If enabled by completion, and the first argument after the program name
+     * is \c __complete, no parsing happens; instead the matching option names
+     * for the last argument are printed one per line, and the program exits.
+     * This is the hidden entry point shells may call for dynamic completion,
+     * although the scripts generated by completion_script do not need it.
      */
     struct INFO_CLI_API cli_parser {
         /**
@@ -152,6 +240,108 @@ namespace info::cli {
          * \copydoc operator()
          */
         std::vector<std::string_view> operator()(std::size_t argc, char** argv);
+        /**
+         * \brief Calls the parsing logic, returning the operands in the given memory resource
+         *
+         * Same as the other operator() overloads, but the returned vector
+         * allocates from \c resource. Together with a parser constructed on
+         * a memory resource, parsing does not touch the global heap, unless
+         * an exception is thrown or the Auto-Help is printed.
+         *
+         * \param argc The number of strings in \c argv
+         * \param argv An array of C-strings as given to the program through main
+         * \param resource The memory resource for the returned vector
+         *
+         * \return A vector of string_views containing the operands in order of encounter
+         */
+        std::pmr::vector<std::string_view>
+        operator()(std::size_t argc, char** argv, std::pmr::memory_resource* resource);
+        /**
+         * \brief Calls the parsing logic on the NUL-separated arguments of a buffer
+         *
+         * Parses a command line stored as one contiguous buffer, with each
+         * argument terminated by a NUL character, the way Linux exposes it
+         * in <tt>/proc/&lt;pid&gt;/cmdline</tt>. The arguments are parsed
+         * in place; the first one is the program name, as in \c argv. The
+         * hidden \c __complete mode is not entered for buffers, as they are
+         * not the command line of this program.
+         *
+         * For parsing many buffers without allocating for each, see
+         * buffer_parser.
+         *
+         * \warning The returned string_views view the buffer, so they are only
+         * valid while it is alive. Only the last argument, if it is not
+         * terminated, is copied; the values given to the callbacks for it
+         * are only valid during the call.
+         *
+         * \param args The arguments, each terminated by a NUL character
+         *
+         * \return A vector of string_views containing the operands in order of encounter
+         */
+        std::vector<std::string_view> operator()(std::string_view args);
+        /**
+         * \brief Calls the parsing logic, handing each operand to the given sink
+         *
+         * Same as the other operator() overloads, but instead of collecting
+         * the operands into a vector, \c sink is called with each of them,
+         * in order, as they are found, including the ones after \c \-\-.
+         * Thus the memory used does not depend on the amount of operands.
+         *
+         * \warning The string_views given to the sink are only valid until
+         * \c argv is alive, the same as with the returned vector.
+         *
+         * \tparam Sink A callable type, taking a \c std::string_view
+         *
+         * \param argc The number of strings in \c argv
+         * \param argv An array of C-strings as given to the program through main
+         * \param sink The callable to call with each operand
+         */
+        template<class Sink,// clang-format off
+                 typename std::enable_if<
+                    std::is_invocable_v<Sink&, std::string_view>
+                 >::type* = nullptr
+        >// clang-format on
+        void
+        operator()(std::size_t argc, char** argv, Sink&& sink) {
+            parse(argc, argv, operand_sink(sink));
+        }
+        /**
+         * \brief Parses the known options, and leaves the rest in argv, ready to exec
+         *
+         * Meant for wrappers, which parse their own few options and pass
+         * everything else to a child process. The callbacks of the known
+         * options, and their values, are called as by operator(). Every
+         * other argument is forwarded: the program name, the operands, and
+         * the unknown options, whatever the unknown_behavior is set to. The
+         * forwarded arguments are moved to the front of \c argv in their
+         * original order, so unknown options keep the values following
+         * them, and \c argv is terminated by a null pointer after them.
+         * Nothing is copied, and nothing is allocated.
+         *
+         * At \c \-\-, or with forwarding::posix at the first operand,
+         * parsing stops, and it, with everything after it, is forwarded
+         * as-is, without filling operand slots. A group of short options
+         * mixing known and unknown ones is forwarded whole, after the
+         * known ones were parsed.
+         *
+         * \verbatim
+         * int argc2 = argc;
+         * auto child = cli.forward(argc2, argv, ic::forwarding::posix);
+         * // wrapper -v gcc -c x.c => child is { "wrapper", "gcc", "-c", "x.c" }
+         * execvp(child[1], child + 1);
+         * \endverbatim
+         *
+         * \warning \c argv needs room for the terminating null pointer after
+         * its last argument, as the one given to main has. If an exception is
+         * thrown, \c argv is left partially compacted.
+         *
+         * \param argc The number of strings in \c argv; set to the number of forwarded ones
+         * \param argv An array of C-strings as given to the program through main; compacted in place
+         * \param mode Where parsing stops, and the rest is forwarded as-is
+         *
+         * \return The forwarded arguments; \c argv itself
+         */
+        char* const* forward(int& argc, char** argv, forwarding mode = forwarding::interleaved);
         /**
          * Adds a custom message to the usage text in the Auto-help.
          *
@@ -159,6 +349,29 @@ namespace info::cli {
          * \return This cli_parser object
          */
         cli_parser& operator[](std::string_view usage_msg);
+        /**
+         * \brief Adds constraints on which options must, or must not be given together
+         *
+         * The constraints are checked after every parse, and if any of them
+         * are violated, a constraint_error is thrown describing all the
+         * violated ones. They are compiled into bit masks here, so checking
+         * them only costs a few word operations per constraint, regardless
+         * of the number of options. May be called multiple times, each
+         * adding to the constraints.
+         *
+         * \verbatim
+         * cli.constraints({ic::required("output"),
+         *                  ic::exactly_one_of("a", "b", "c"),
+         *                  ic::implies("x", "y")});
+         * \endverbatim
+         *
+         * \throws std::invalid_argument if a constraint names an unknown option
+         *
+         * \param cons The constraints
+         * \return This cli_parser object
+         */
+        cli_parser& constraints(std::initializer_list<constraint> cons);
+
         /**
          * \brief Returns the number of options
          *
@@ -168,6 +381,82 @@ namespace info::cli {
          */
         [[nodiscard]] INFO_CLI_PURE std::size_t size() const noexcept;
 
+        /**
+         * \brief Returns the options that complete a partially typed argument
+         *
+         * Looks up every registered option whose name starts with the given
+         * partial argument, and returns them spelled as they would be on the
+         * command line, that is, with their leading dashes, in lexicographic
+         * order. An argument that does not begin with a dash is an operand,
+         * thus it has no completions.
+         *
+         * The lookup is done on a sorted index built during construction, so
+         * it only costs a binary search and the walk over the matches.
+         *
+         * \param partial The partially typed argument, with its dashes
+         *
+         * \return The option spellings that complete \c partial
+         */
+        [[nodiscard]] std::vector<std::string> complete(std::string_view partial) const;
+
+        /**
+         * \brief Generates a static completion script for the given shell
+         *
+         * Creates a script which, when sourced by (or installed for) the
+         * given shell, completes the options of the program without ever
+         * executing it. Help descriptions are included where the shell
+         * can display them.
+         *
+         * \param sh The shell to generate the script for
+         * \param program The name of the program to complete as typed by the user
+         *
+         * \return The completion script
+         */
+        [[nodiscard]] std::string completion_script(shell sh, std::string_view program) const;
+
+        /**
+         * \brief Freezes the immutable part of the parser into a binary blob
+         *
+         * Serializes everything the parser knows about its options, except
+         * the callbacks: the name table, the type information, and the text
+         * of the Auto-Help. The blob is flat and only contains offsets relative
+         * to its beginning, so it can be embedded in an executable or stored
+         * on disk and mapped into memory, see mapped_snapshot.
+         *
+         * The blob can be loaded by the from_snapshot constructor, which
+         * relinks the callbacks by the index of the option they belonged
+         * to in the original parser. The blob is only meant to be loaded by
+         * the same version of InfoCLI on the same platform that created it.
+         *
+         * \throws std::logic_error if the parser has operand slots, as those
+         * are not stored in snapshots
+         *
+         * \return The binary blob representing this parser
+         */
+        [[nodiscard]] std::string snapshot() const;
+
+        /**
+         * \brief Compacts the parser into the snapshot layout, in place
+         *
+         * Serializes the parser as snapshot() does, into a single cache line
+         * aligned slab owned by the parser, then frees the hash map of the
+         * options and the help structures. Lookups afterwards go through the
+         * open addressing index of the slab: every name points to its type
+         * descriptor by a one byte index, and the descriptors are stored
+         * once for every distinct type, so finding an option touches only
+         * a few cache lines.
+         *
+         * The slab is never written after the freeze, so processes forked
+         * after it share its pages without copying them. Unlike snapshot(),
+         * operand slots are allowed, as they stay outside the slab with the
+         * callbacks. Freezing a frozen parser, or one loaded from a snapshot,
+         * does nothing.
+         *
+         * \throws std::length_error if the options have more than 256
+         * distinct types
+         */
+        void freeze();
+
         /**
          * Sets behavior when encountering unknown options.
          *
@@ -181,6 +470,71 @@ namespace info::cli {
             _unk_behavior = behavior;
         }
 
+        /**
+         * Sets how the names of long options are matched.
+         *
+         * With name_matching::folded, the names of long options given on the
+         * command line match the registered names regardless of case, dashes,
+         * and underscores. The registered names are indexed once here, by
+         * a hash of their folded form; the arguments are folded while hashing
+         * and comparing them, so matching does not copy them. Unless changed,
+         * the matching of a cli_parser is \c exact.
+         *
+         * \throws std::invalid_argument if two names of different options are
+         * the same when folded; the matching is left unchanged
+         *
+         * \param matching The new matching
+         */
+        void name_matching(enum name_matching matching);
+
+        /**
+         * Sets whether to count the options before parsing.
+         *
+         * If enabled, the arguments are first counted per option, and the
+         * aggregating variables which can reserve room, like \c std::vector,
+         * are reserved once for all their values, instead of reallocating
+         * as the values come in one by one. This costs an extra pass over
+         * the arguments, therefore, unless changed, it is disabled.
+         *
+         * \param enable Whether to perform the counting pass
+         */
+        void
+        presize(bool enable) noexcept {
+            _presize = enable;
+        }
+
+        /**
+         * Sets whether to answer the hidden \c __complete queries.
+         *
+         * If enabled, and the first argument after the program name is
+         * \c __complete, parsing prints the options completing the last
+         * argument, and exits the program. As it exits, it is only fit for
+         * parsing the command line of the program itself, therefore, unless
+         * changed, it is disabled, and \c __complete is a plain operand.
+         *
+         * \param enable Whether to answer the completion queries
+         */
+        void
+        completion(bool enable) noexcept {
+            _completion = enable;
+        }
+
+        /**
+         * Sets how many threads run the validators after parsing.
+         *
+         * The values of options with validators are checked after the command
+         * line is parsed, on this many threads, including the one calling
+         * the parser. Unless changed, or set to 0, it is the amount of
+         * hardware threads. Never more threads are started than there
+         * are values to check.
+         *
+         * \param threads The maximal amount of threads to use for validation
+         */
+        void
+        validation_threads(std::size_t threads) noexcept {
+            _validation_threads = threads;
+        }
+
         /**
          * \brief Create the cli_parser with the given options
          *
@@ -193,36 +547,333 @@ namespace info::cli {
          */
         cli_parser(std::initializer_list<option> opts);
 
+        /**
+         * \brief Create the cli_parser with the given options in a memory resource
+         *
+         * Same as the constructor without a memory resource, but all of the
+         * parser's own storage is allocated from \c resource, instead of
+         * the global heap. The resource must outlive the parser.
+         *
+         * \note Callbacks are stored in \c std::function objects, which
+         * allocate on the global heap if the callback is too large for their
+         * small-object buffer. The callbacks created by the DSL for variable
+         * references always fit.
+         *
+         * \param opts The set of options to handle during parsing
+         * \param resource The memory resource to allocate from
+         */
+        cli_parser(std::initializer_list<option> opts, std::pmr::memory_resource* resource);
+
+        /**
+         * \brief Create the cli_parser by moving in the given options
+         *
+         * Same as the constructor taking an \c std::initializer_list, but
+         * the callbacks are moved out of the options, instead of being copied,
+         * as the elements of an \c std::initializer_list are always const.
+         * For large sets of options this saves a copy of every callback.
+         *
+         * \param opts The set of options to handle during parsing, moved from
+         */
+        explicit cli_parser(std::vector<option>&& opts);
+
+        /**
+         * \copybrief cli_parser(std::vector<option>&&)
+         *
+         * Same as the constructor without a memory resource, but all of the
+         * parser's own storage is allocated from \c resource.
+         *
+         * \param opts The set of options to handle during parsing, moved from
+         * \param resource The memory resource to allocate from
+         */
+        cli_parser(std::vector<option>&& opts, std::pmr::memory_resource* resource);
+
+        /**
+         * \brief Create the cli_parser by moving in the options given as arguments
+         *
+         * The move-only counterpart of the braced constructor: options are
+         * given in parentheses, and are moved into the parser.
+         *
+         * \verbatim
+         * cli_parser cli('o'_opt / "output" >>= output,
+         *                'O'_opt >>= optlvl);
+         * \endverbatim
+         *
+         * \tparam Options The types of the rest of the options; all cli::option rvalues
+         *
+         * \param first The first option
+         * \param rest The rest of the options
+         */
+        template<class... Options,// clang-format off
+                 typename std::enable_if<
+                    (std::is_same_v<Options, option> && ...)
+                 >::type* = nullptr
+        >// clang-format on
+        explicit cli_parser(option&& first, Options&&... rest)
+             : cli_parser(std::array<option*, 1 + sizeof...(Options)>{&first, &rest...}.data(),
+                          1 + sizeof...(Options)) { }
+
+        /**
+         * \brief Loads a cli_parser from a snapshot
+         *
+         * Creates a cli_parser which uses the name table, type information,
+         * and help text stored in the snapshot blob directly, without copying
+         * or rehashing anything. As the blob may come from a file, its records
+         * are checked once, in a single pass, which is all loading costs per
+         * option.
+         *
+         * The callbacks are relinked by index: the nth callback is called
+         * for the nth option given to the parser the snapshot was taken of.
+         * Callbacks for the DSL's variable references and functors can be
+         * created with make_callback. The Auto-Help's callback is restored
+         * automatically.
+         *
+         * \warning The blob is not copied, it must outlive the created parser.
+         *
+         * \throws std::invalid_argument if the blob is not a valid snapshot, or
+         * the amount of callbacks does not match the amount of options in it
+         *
+         * \param blob The snapshot created by snapshot()
+         * \param callbacks The callbacks of the options, in order of definition
+         */
+        cli_parser(from_snapshot_t,
+                   std::string_view blob,
+                   std::vector<std::function<option::callback_type>> callbacks);
+
+        /**
+         * \brief Moves the parser, with its storage and memory resource
+         *
+         * The names and help messages are views into the parser's own
+         * storage, which is taken over, thus they stay valid.
+         *
+         * \param other The parser to move from; must not be used afterwards
+         */
+        cli_parser(cli_parser&& other) noexcept;
+
+        /**
+         * \brief cli_parser is not copyable
+         *
+         * The tables of the options view the parser's own storage, so a copy
+         * would view the original's. Assignment is deleted as well, as moving
+         * between different memory resources copies the storage.
+         */
+        cli_parser(const cli_parser&) = delete;
+        cli_parser& operator=(const cli_parser&) = delete;
+        cli_parser& operator=(cli_parser&&) = delete;
+
+    protected:
+        /**
+         * \brief A type-erased reference to where the operands go during parsing
+         *
+         * Wraps a reference to any container with an \c emplace_back member
+         * function taking a string_view, or to a callable taking a string_view,
+         * so the parsing logic does not depend on what, and in which memory,
+         * the operands are collected into, if they are collected at all.
+         */
+        struct operand_sink {
+            /**
+             * \brief Creates the sink appending to the given container, or calling the given callable
+             *
+             * \param cont The container to append operands to, or the callable
+             *             to call with them; must outlive the sink
+             */
+            template<class C>
+            explicit operand_sink(C& cont) noexcept
+                 : _target(const_cast<void*>(static_cast<const void*>(&cont))),
+                   _push([](void* target, std::string_view op) {
+                       if constexpr (std::is_invocable_v<C&, std::string_view>) {
+                           (*static_cast<C*>(target))(op);
+                       } else {
+                           static_cast<C*>(target)->emplace_back(op);
+                       }
+                   }) { }
+
+            /// Appends the operand to the container
+            void
+            operator()(std::string_view op) const {
+                _push(_target, op);
+            }
+
+        private:
+            void* _target;
+            void (*_push)(void*, std::string_view);
+        };
+
+        /**
+         * \brief The parsing logic behind all operator() overloads
+         *
+         * \param argc The number of strings in \c argv
+         * \param argv An array of C-strings as given to the program through main
+         * \param ops Where to put the operands
+         */
+        void parse(std::size_t argc, char** argv, operand_sink ops);
+
     private:
+        friend class push_parser;
+        friend class buffer_parser;
+        friend class batch_parser;
+        friend class config_source;
+
         /**
          * \brief POD containing the required information to perform a callback
          *         when an option is found and requires so.
          */
         struct INFO_CLI_LOCAL option_info {
             rt_type_data type_data;
-            std::size_t callback;
+            std::size_t callback;///< The index of the callback, also the dense id of the option
         };
 
         using callback_type = std::function<bool(std::string_view, const char*&)>;
-        using options_type = std::unordered_map<std::string, option_info>;
+        using options_type = std::pmr::unordered_map<std::string_view, option_info>;
+        using folded_options_type = std::pmr::unordered_map<std::string_view, option_info, _cli::folded_hash, _cli::folded_equal>;
         using help_innards = std::pair<std::string_view, const option_info*>;
         using help_type = _cli::help_text<help_innards>;
 
-        std::vector<callback_type> _callbacks;
-        options_type _options;
-        std::unordered_set<help_type> _helps;
-        std::string _exec;
-        std::string _usage_msg;
+        /// An operand slot, filled by the operands in order
+        struct INFO_CLI_LOCAL operand_slot {
+            rt_type_data type_data;
+            std::size_t callback;
+            std::string_view name;
+            std::string_view help;
+            bool rest;///< Whether the slot takes every remaining operand
+        };
+
+        /// A constraint compiled into a bit mask over the ids of the options
+        struct INFO_CLI_LOCAL compiled_constraint {
+            constraint_kind kind;
+            std::size_t mask;   ///< The offset of the mask in _constraint_masks
+            std::size_t trigger;///< The id of the option with the dependencies, for implies
+            std::string message;///< The description of the violation
+        };
+
+        /// A value seen during parsing, to be checked by the validator of its option
+        struct INFO_CLI_LOCAL pending_validation {
+            std::size_t validator;
+            std::string_view name;
+            std::string_view value;
+        };
+
+        /// The unit of the frozen slab, aligned to a cache line
+        struct alignas(64) frozen_block {
+            std::byte bytes[64];
+        };
+
+        std::pmr::memory_resource* _resource = std::pmr::get_default_resource();
+        std::pmr::vector<callback_type> _callbacks{_resource};
+        std::pmr::vector<std::function<option::reserve_type>> _reservers{_resource};
+        std::pmr::vector<std::size_t> _presize_counts{_resource};///< The counts of the options in the presize pass, by id
+        std::pmr::vector<std::function<option::validator_type>> _validators{_resource};
+        std::pmr::vector<pending_validation> _pending{_resource};///< The values to validate after the parse
+        std::pmr::vector<char> _strings{_resource};///< The pool of names and help messages; the keys of _options view this
+        options_type _options{_resource};
+        folded_options_type _folded{_resource};///< The long options by their folded names, if they are matched folded
+        std::pmr::unordered_set<help_type> _helps{_resource};
+        std::string_view _exec;///< The file name in argv[0] during the parse
+        std::pmr::string _usage_msg{_resource};
+        std::pmr::vector<std::string_view> _prefix_index{_resource};
+        std::pmr::vector<operand_slot> _operand_slots{_resource};
+        std::size_t _next_slot = 0;///< The operand slot the next operand goes into during the parse
+        std::pmr::vector<std::uint64_t> _seen{_resource};///< The bit set of the ids of the options given during the parse
+        std::pmr::vector<compiled_constraint> _constraints{_resource};
+        std::pmr::vector<std::uint64_t> _constraint_masks{_resource};///< The masks of the constraints, each _seen.size() words
+        bool _pushing = false;///< Whether a push_parser is parsing, so options may wait for their values
+        bool _forwarding = false;///< Whether forward is parsing, so unknown options and everything after \c -- are operands
+        enum forwarding _forwarding_mode = forwarding::interleaved;
+        std::optional<option_info> _awaiting;///< The option waiting for its value in the next pushed argument
+        std::pmr::string _awaiting_name{_resource};
+        std::string_view _snapshot;
+        std::pmr::vector<frozen_block> _slab{_resource};///< The storage of _snapshot after freeze
+        bool _auto_help = false;
+        bool _presize = false;
+        bool _completion = false;
+        std::size_t _validation_threads = 0;
         enum unknown_behavior _unk_behavior = unknown_behavior::classic;
 
+        /// The constructor behind the variadic one, taking the options by pointer
+        cli_parser(option* const* opts, std::size_t count);
+
+        /// Registers the options; moves the callbacks out of them, unless they are const
+        template<class Get>
+        INFO_CLI_LOCAL void add_options(std::size_t count, Get get);
+        /// Copies the string into the pool and returns the view of the copy
+        INFO_CLI_LOCAL std::string_view pooled(std::string_view str);
+
+        /// Looks up the option by name, in the folded names, the options map, or the snapshot
+        [[nodiscard]] INFO_CLI_LOCAL std::optional<option_info> find_option(std::string_view name) const;
+        /// Serializes the parser into the snapshot layout
+        [[nodiscard]] INFO_CLI_LOCAL std::string serialize() const;
+        /// Looks up the option by name in the snapshot
+        [[nodiscard]] INFO_CLI_LOCAL std::optional<option_info> find_snapshot_option(std::string_view name) const;
+        /// Returns the usage options, or the options help if \c usage is false, from the snapshot
+        [[nodiscard]] INFO_CLI_LOCAL std::string_view snapshot_help(bool usage) const;
+        /// Returns the amount of names in the snapshot
+        [[nodiscard]] INFO_CLI_LOCAL std::size_t snapshot_name_count() const noexcept;
+        /// Returns the idx-th name of the snapshot in sorted order
+        [[nodiscard]] INFO_CLI_LOCAL std::string_view snapshot_name(std::size_t idx) const noexcept;
+        /// Returns the help description of the idx-th name of the snapshot
+        [[nodiscard]] INFO_CLI_LOCAL std::string_view snapshot_option_help(std::size_t idx) const noexcept;
+        /// Returns the amount of names in the prefix index
+        [[nodiscard]] INFO_CLI_LOCAL std::size_t sorted_name_count() const noexcept;
+        /// Returns the idx-th name of the prefix index
+        [[nodiscard]] INFO_CLI_LOCAL std::string_view sorted_name(std::size_t idx) const noexcept;
+        /// Returns the help description of each documented option name
+        [[nodiscard]] INFO_CLI_LOCAL std::unordered_map<std::string_view, std::string_view> help_map() const;
+        /// Returns the short options and the long option placeholder for the usage line
+        [[nodiscard]] INFO_CLI_LOCAL std::string usage_options() const;
+        /// Returns the list of options and their descriptions for the Auto-Help
+        [[nodiscard]] INFO_CLI_LOCAL std::string options_help() const;
+        /// Prints the Auto-Help and exits
+        [[noreturn]] INFO_CLI_LOCAL void print_help() const;
+
         /// The function to handle encountering a short option (packed or not)
-        void short_option(std::vector<std::string_view>& ops, char* arg, size_t argc, char** argv, size_t& i);
+        INFO_CLI_LOCAL void short_option(operand_sink& ops, std::string_view arg, size_t argc, char** argv, size_t& i);
         /// The function handling singular, not packed short options
-        void unpacked_shorts(std::vector<std::string_view>& ops, char* arg, size_t argc, char** argv, size_t& i);
-        /// The function handling packed options
-        void packed_shorts(std::vector<std::string_view>& ops, char* arg, size_t argc, char** argv, size_t& i);
+        INFO_CLI_LOCAL void unpacked_shorts(operand_sink& ops, std::string_view arg, size_t argc, char** argv, size_t& i);
+        /**
+         * The function handling one step of a packed option group
+         *
+         * \return The rest of the group still to be handled, or empty if the
+         *          group was consumed
+         */
+        INFO_CLI_LOCAL std::string_view packed_shorts(operand_sink& ops, std::string_view arg, size_t argc, char** argv, size_t& i);
+        /// Counts the options in the arguments and reserves the aggregating ones
+        INFO_CLI_LOCAL void presize_aggregates(std::size_t argc, char** argv);
+        /// Calls the callback, and queues the value for validation if the option has a validator
+        INFO_CLI_LOCAL bool call(std::size_t idx, std::string_view name, std::string_view value, const char*& last);
+        /// Runs the validators on the queued values, throws validation_error if any fail
+        INFO_CLI_LOCAL void run_validators();
+        /// Clears the set of options given, before a parse
+        INFO_CLI_LOCAL void reset_seen();
+        /// Returns the id of the option or operand slot, and its spelling on the command line
+        [[nodiscard]] INFO_CLI_LOCAL std::pair<std::size_t, std::string> constraint_target(std::string_view name) const;
+        /// Checks the constraints on the options given, throws constraint_error if any are violated
+        INFO_CLI_LOCAL void check_constraints() const;
         /// Handles long options, GNU-style or not
-        void long_option(std::vector<std::string_view>& ops, size_t argc, char** argv, size_t& i);
+        INFO_CLI_LOCAL void long_option(operand_sink& ops, size_t argc, char** argv, size_t& i);
+        /// Handles an operand, by filling the next operand slot, or putting it into the sink
+        INFO_CLI_LOCAL void operand(operand_sink& ops, char* arg);
+        /// The parsing logic of parse, without the \c __complete mode
+        INFO_CLI_LOCAL void parse_arguments(std::size_t argc, char** argv, operand_sink ops);
+        /// Handles the argument, which is not the program name or \c \-\-
+        INFO_CLI_LOCAL void argument(operand_sink& ops, size_t argc, char** argv, size_t& i);
+        /// Makes the option wait for its value in the next pushed argument
+        INFO_CLI_LOCAL void await_value(std::string_view name, const option_info& opt);
+
+        /// Prepares the parser for the arguments of a push_parser
+        INFO_CLI_LOCAL void start_push();
+        /// Parses an argument given to a push_parser; operands_only is set after \c \-\-
+        INFO_CLI_LOCAL void push_argument(operand_sink& ops, char* arg, bool& operands_only);
+        /// Ends the input of a push_parser, throws if an option is waiting for its value
+        INFO_CLI_LOCAL void finish_push();
+        /// Ends the parsing of a push_parser
+        INFO_CLI_LOCAL void stop_push() noexcept;
+
+        /// Sorts the names of the registered options for prefix lookup
+        INFO_CLI_LOCAL void build_prefix_index();
+        /// Calls \c fn with each option name (dashes stripped) completing \c partial
+        template<class Fn>
+        INFO_CLI_LOCAL void for_each_completion(std::string_view partial, Fn&& fn) const;
+        /// Prints the completions for the hidden \c __complete mode
+        INFO_CLI_LOCAL void print_completions(std::size_t argc, char** argv) const;
 
         /**
          * Strips the beginning dash (or two dashes) from an option argument.
@@ -233,11 +884,11 @@ namespace info::cli {
          *
          * \return A C-string pointing at the non-dash character of the original C-string
          */
-        [[nodiscard]] INFO_CLI_PURE static char* strip_option(char* opt, bool lng = false);
+        [[nodiscard]] INFO_CLI_LOCAL INFO_CLI_PURE static char* strip_option(char* opt, bool lng = false);
         /**
          * \copydoc strip_option
          */
-        [[nodiscard]] INFO_CLI_PURE static const char* strip_option(const char* opt, bool lng = false);
+        [[nodiscard]] INFO_CLI_LOCAL INFO_CLI_PURE static const char* strip_option(const char* opt, bool lng = false);
 
         /**
          * Handle receiving an invalid option
@@ -246,9 +897,23 @@ namespace info::cli {
          *
          * \param ops The set of operands in the current parsing operation
          * \param opt The option which could not be matched to the known options
+         * \param arg The argument the option was found in
          */
-        void
-        invalid_option(std::vector<std::string_view>& ops, const std::string& opt, char* arg);
+        INFO_CLI_LOCAL void
+        invalid_option(operand_sink& ops, std::string_view opt, char* arg);
+
+        /// Hands the argument at \c i, and everything after it, to the operands as-is, while forwarding
+        INFO_CLI_LOCAL void
+        forward_rest(operand_sink& ops, std::size_t argc, char** argv, std::size_t i);
     };
 
 }
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../src/cli_parser.cxx"
+#    include "../../../src/completion.cxx"
+#    include "../../../src/name_matching.cxx"
+#    include "../../../src/forwarding.cxx"
+#    include <info/cli/buffer_parser.hxx>
+#    include <info/cli/snapshot.hxx>
+#endif
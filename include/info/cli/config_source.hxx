@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines config_source, which applies the options of a configuration file
+ * to a cli_parser, and re-applies the ones that change while the file is
+ * edited.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/macros.hxx>
+
+namespace info::cli {
+    /**
+     * \brief Applies the options of a configuration file, and watches it for changes
+     *
+     * The file has one option per line, as <tt>name = value</tt>, where the
+     * name is the name of the option without dashes. A line without an
+     * \c = gives the option without a value, like a flag on the command
+     * line. Whitespace around names and values, empty lines, and lines
+     * starting with \c # are ignored. If a name is given more than once, the
+     * last one is used.
+     *
+     * On construction every option in the file is applied: its callback is
+     * called with its value, found the same way cli_parser::operator() finds
+     * options, and its validator, if any, is run. The file is then watched:
+     * with inotify on Linux, where the directory of the file is watched, so
+     * editors replacing the file are noticed, and by its modification time
+     * elsewhere. poll applies the changes made since.
+     *
+     * A reload diffs the options in the file against the ones applied
+     * last, and only calls the callbacks of the options whose values
+     * changed, or which were added. Options removed from the file are
+     * forgotten, and keep their last values, as there is nothing to call
+     * their callbacks with.
+     *
+     * \verbatim
+     * cli::config_source config(cli, "/etc/daemon.conf");
+     * for (;;) {
+     *     wait_for_input(config.native_handle());
+     *     config.poll();
+     * }
+     * \endverbatim
+     *
+     * \warning The string_views given to the callbacks view the contents of
+     * the file read last, so they are only valid until the next reload.
+     *
+     * \note A config_source is not thread safe, and must not apply options
+     * while the cli_parser parses.
+     */
+    class INFO_CLI_API config_source {
+    public:
+        /**
+         * \brief Applies every option of the file, and starts watching it
+         *
+         * \throws std::system_error if the file cannot be read or watched
+         * \throws Anything cli_parser::operator() throws for the options
+         *
+         * \param parser The parser whose options are applied; must outlive the config_source
+         * \param path The path of the configuration file
+         */
+        config_source(cli_parser& parser, std::string path);
+
+        config_source(const config_source&) = delete;
+        config_source& operator=(const config_source&) = delete;
+
+        /// Stops watching the file
+        ~config_source();
+
+        /**
+         * \brief Applies the changes of the file, if it changed since the last reload
+         *
+         * Does not block: if the file was not changed, returns immediately.
+         *
+         * \throws std::system_error if the file cannot be read
+         * \throws Anything cli_parser::operator() throws for the changed options
+         *
+         * \return The number of options whose callbacks were called
+         */
+        std::size_t poll();
+
+        /**
+         * \brief Reads the file, and applies its changes, whether it was changed or not
+         *
+         * \throws std::system_error if the file cannot be read
+         * \throws Anything cli_parser::operator() throws for the changed options
+         *
+         * \return The number of options whose callbacks were called
+         */
+        std::size_t reload();
+
+        /**
+         * \brief Returns the file descriptor readable when the file changes
+         *
+         * The descriptor can be waited on with \c poll or \c epoll in an
+         * event loop, instead of calling poll periodically.
+         *
+         * \return The inotify descriptor, or -1 if inotify is not available
+         */
+        [[nodiscard]] int native_handle() const noexcept;
+
+    private:
+        cli_parser& _parser;
+        std::string _path;
+        std::vector<char> _contents;///< The file read last; _applied views it
+        std::unordered_map<std::string_view, std::string_view> _applied;///< The values of the options applied, by name; null if given without one
+        std::int64_t _modified = 0;///< The modification time of the file read last, where inotify is not available
+        int _watch = -1;///< The inotify descriptor
+
+        /// Calls the callback of the option with the value, or its default if the value is null
+        void apply(std::string_view name, std::string_view value);
+    };
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../src/config_source.cxx"
+#endif
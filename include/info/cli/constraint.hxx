@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines the constraints between options checked after parsing, like
+ * required options, or options which cannot be given together.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace info::_cli {
+    /// Returns the name of an option in a constraint, either a string or a character
+    inline std::string
+    constraint_name(std::string_view name) {
+        return std::string(name);
+    }
+
+    /// \copydoc constraint_name(std::string_view)
+    inline std::string
+    constraint_name(char name) {
+        return std::string(1, name);
+    }
+}
+
+namespace info::cli {
+    /**
+     * \brief The kinds of constraints between options
+     */
+    enum class constraint_kind {
+        required,          ///< Every option must be given
+        exactly_one_of,    ///< Exactly one of the options must be given
+        mutually_exclusive,///< At most one of the options may be given
+        implies            ///< If the first option is given, the rest must be too
+    };
+
+    /**
+     * \brief A constraint on which options are given together
+     *
+     * Created by the functions cli::required, cli::exactly_one_of,
+     * cli::mutually_exclusive, and cli::implies, and given to the cli_parser
+     * with cli_parser::constraints. Options are referred to by any of their
+     * names or aliases, without the dashes; operand slots by their names.
+     */
+    struct constraint {
+        constraint_kind kind;          ///< What is required of the options
+        std::vector<std::string> names;///< The options constrained
+    };
+
+    /**
+     * \brief Requires each of the options to be given
+     *
+     * \param names The names of the required options
+     * \return The constraint to give to cli_parser::constraints
+     */
+    template<class... Names>
+    constraint
+    required(Names&&... names) {
+        return {constraint_kind::required, {_cli::constraint_name(std::forward<Names>(names))...}};
+    }
+
+    /**
+     * \brief Requires exactly one of the options to be given
+     *
+     * \param names The names of the options
+     * \return The constraint to give to cli_parser::constraints
+     */
+    template<class... Names>
+    constraint
+    exactly_one_of(Names&&... names) {
+        return {constraint_kind::exactly_one_of, {_cli::constraint_name(std::forward<Names>(names))...}};
+    }
+
+    /**
+     * \brief Allows at most one of the options to be given
+     *
+     * \param names The names of the options
+     * \return The constraint to give to cli_parser::constraints
+     */
+    template<class... Names>
+    constraint
+    mutually_exclusive(Names&&... names) {
+        return {constraint_kind::mutually_exclusive, {_cli::constraint_name(std::forward<Names>(names))...}};
+    }
+
+    /**
+     * \brief Requires the dependencies to be given, if the option is given
+     *
+     * \param name The name of the option with the dependencies
+     * \param dependencies The names of the options required by it
+     * \return The constraint to give to cli_parser::constraints
+     */
+    template<class Name, class... Names>
+    constraint
+    implies(Name&& name, Names&&... dependencies) {
+        return {constraint_kind::implies,
+                {_cli::constraint_name(std::forward<Name>(name)),
+                 _cli::constraint_name(std::forward<Names>(dependencies))...}};
+    }
+}
@@ -25,6 +25,9 @@ namespace info::cli {
         /**
          * \brief Returns a string explaining the error
          *
+         * The string is built by the constructor, so what may be called
+         * from any thread, and it does not reflect later changes to the fields.
+         *
          * \return A string explaining the error which can be printed as-is, if need be
          */
         [[nodiscard]] const char* what() const noexcept override;
@@ -45,5 +48,12 @@ namespace info::cli {
         std::string opt_name; ///< The name of the failed option
         std::string_view type;///< The type of the failed option
         std::string args;     ///< What the parser found for the value for the option
+
+    private:
+        std::string _message;///< The string returned by what, built on construction
     };
 }
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../../src/exc/bad_option_value.cxx"
+#endif
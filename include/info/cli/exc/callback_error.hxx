@@ -37,5 +37,12 @@ namespace info::cli {
 
         std::string opt_name;///< The name of the failed callback's option
         std::string args;    ///< The value for which the callback failed
+
+    private:
+        std::string _message;///< The string returned by what, built on construction
     };
 }
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../../src/exc/callback_error.cxx"
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines constraint_error exception thrown when the options given on the
+ * command line violate the constraints of the parser
+ */
+#pragma once
+
+#include <exception>
+#include <string>
+#include <vector>
+
+#include <info/cli/macros.hxx>
+
+namespace info::cli {
+    /**
+     * \brief Exception for when the options given violate constraints
+     *
+     * The constraints given to cli_parser::constraints are checked after
+     * the whole command line is parsed, and every violated one is collected
+     * into this exception, so all of them can be reported at once.
+     */
+    struct INFO_CLI_API constraint_error : std::exception {
+        /// \copydoc bad_option_value::what()
+        [[nodiscard]] const char* what() const noexcept override;
+
+        /**
+         * \brief Constructs a constraint_error exception
+         *
+         * \param violations The descriptions of the violated constraints,
+         *                   in the order the constraints were given
+         */
+        explicit constraint_error(std::vector<std::string> violations);
+
+        std::vector<std::string> violations;///< The descriptions of the violated constraints
+
+    private:
+        std::string _message;///< The string returned by what, built on construction
+    };
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../../src/exc/constraint_error.cxx"
+#endif
@@ -35,5 +35,12 @@ namespace info::cli {
         explicit no_such_option(std::string opt_name);
 
         std::string opt_name;///< The name of the unrecognized option
+
+    private:
+        std::string _message;///< The string returned by what, built on construction
     };
 }
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../../src/exc/no_such_option.cxx"
+#endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines validation_error exception thrown when the validators of options
+ * found values they do not accept
+ */
+#pragma once
+
+#include <exception>
+#include <string>
+#include <vector>
+
+#include <info/cli/macros.hxx>
+
+namespace info::cli {
+    /**
+     * \brief Exception for when validators reject values after parsing
+     *
+     * The validators attached to options with validate are run after the
+     * whole command line is parsed, and every value they reject is collected
+     * into this exception, so all of them can be reported at once.
+     */
+    struct INFO_CLI_API validation_error : std::exception {
+        /**
+         * \brief A value rejected by a validator
+         */
+        struct failure {
+            std::string opt_name;///< The option the value was given to
+            std::string value;   ///< The rejected value
+            std::string reason;  ///< Why the validator rejected the value
+        };
+
+        /// \copydoc bad_option_value::what()
+        [[nodiscard]] const char* what() const noexcept override;
+
+        /**
+         * \brief Constructs a validation_error exception
+         *
+         * Takes all the values which failed validation, in order of their
+         * appearance on the command line.
+         *
+         * \param failures The rejected values
+         */
+        explicit validation_error(std::vector<failure> failures);
+
+        std::vector<failure> failures;///< The values rejected by the validators
+
+    private:
+        std::string _message;///< The string returned by what, built on construction
+    };
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../../src/exc/validation_error.cxx"
+#endif
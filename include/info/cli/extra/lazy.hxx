@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Type modifier deferring the parsing of a value until it is first used.
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace info::_cli {
+    /**
+     * \brief Parses the values of a lazy, as the DSL would have eagerly
+     *
+     * Defined along with the type_parser-s, as that is what it uses.
+     *
+     * \tparam T The type of the lazy value
+     *
+     * \param ret The value to aggregate into, or to overwrite
+     * \param name The name of the option, for the errors
+     * \param sources The values given on the command line, in order
+     *
+     * \return The parsed value
+     */
+    template<class T>
+    T parse_lazy(T ret, std::string_view name, const std::vector<std::string_view>& sources);
+}
+
+namespace info::cli {
+    /**
+     * \brief A type modifier deferring the parsing of the value until it is used
+     *
+     * Normally the callbacks of the DSL parse the values of options while the
+     * command line is parsed, even if the program never looks at them. A lazy
+     * value instead only remembers where its value is on the command line,
+     * and runs the type_parser the first time it is dereferenced. The result
+     * is then kept, so the value is parsed at most once.
+     *
+     * \verbatim
+     * cli::lazy<std::vector<double>> samples;
+     * cli::cli_parser cli{'s'_opt >>= samples};
+     * \endverbatim
+     *
+     * Aggregating types are aggregated over all appearances of the option
+     * into the default value when dereferenced, other types take the last
+     * value given, just like they would without the modifier.
+     *
+     * \warning The values are views into \c argv, which must outlive the
+     * lazy value. Parsing errors are not reported by the parser, but
+     * by the first dereference, which throws bad_option_value. Dereferencing
+     * from multiple threads at once is not safe before the value is parsed.
+     *
+     * \note As the end of the value is not known until it is parsed, a lazy
+     * value in a packed group of short options takes the rest of the group.
+     *
+     * \tparam T The type of the value
+     */
+    template<class T>
+    class lazy {
+    public:
+        /// Creates a lazy value, which is a value-initialized \c T unless given
+        lazy() = default;
+
+        /**
+         * \brief Creates a lazy value with a default value
+         *
+         * \param default_value The value used if the option is not given
+         */
+        lazy(T default_value)
+             : _default(default_value),
+               _value(std::move(default_value)) { }
+
+        /**
+         * \brief Whether the option of the value was given on the command line
+         *
+         * \return Whether there is anything to parse
+         */
+        [[nodiscard]] bool
+        given() const noexcept {
+            return !_sources.empty();
+        }
+
+        /**
+         * \brief Whether the value is already parsed, or is the default value
+         *
+         * \return Whether dereferencing will not run the parser
+         */
+        [[nodiscard]] bool
+        parsed() const noexcept {
+            return _value.has_value();
+        }
+
+        /**
+         * \brief The last value given on the command line, as is
+         *
+         * \return The unparsed value, or the empty string if it was not given
+         */
+        [[nodiscard]] std::string_view
+        source() const noexcept {
+            return _sources.empty() ? std::string_view{}
+                                    : _sources.back();
+        }
+
+        /**
+         * \brief Returns the value, parsing it on first use
+         *
+         * \throws bad_option_value if the value given is not valid for \c T
+         *
+         * \return The parsed value
+         */
+        const T&
+        get() const {
+            if (!_value) {
+                _value.emplace(_cli::parse_lazy<T>(_default, _name, _sources));
+            }
+            return *_value;
+        }
+
+        /// \copydoc get()
+        const T&
+        operator*() const {
+            return get();
+        }
+
+        /// \copydoc get()
+        const T*
+        operator->() const {
+            return &get();
+        }
+
+        /**
+         * \brief Records a value found on the command line, without parsing it
+         *
+         * Used by the aggregator of the lazy values during parsing, drops the
+         * already parsed value.
+         *
+         * \param source The value as found on the command line
+         * \param keep_previous Whether to keep the earlier values, for aggregating types
+         */
+        void
+        add_source(std::string_view source, bool keep_previous) {
+            if (!keep_previous) {
+                _sources.clear();
+            }
+            _sources.push_back(source);
+            _value.reset();
+        }
+
+        /**
+         * \brief Sets the name of the option reported by the parsing errors
+         *
+         * Used by the DSL when the lazy value is bound to an option.
+         *
+         * \param name The name of the option
+         */
+        void
+        option_name(std::string name) {
+            _name = std::move(name);
+        }
+
+    private:
+        std::vector<std::string_view> _sources;
+        std::string _name;
+        T _default{};
+        mutable std::optional<T> _value;
+    };
+}
+
+namespace info::_cli {
+    /// \cond DOXYGEN_IGNORE_THIS
+    template<class T>
+    struct is_lazy_ : std::false_type { };
+
+    template<class T>
+    struct is_lazy_<cli::lazy<T>> : std::true_type { };
+    /// \endcond
+
+    /**
+     * \brief Whether the type is a lazy value
+     *
+     * \tparam T The type to check
+     */
+    template<class T>
+    constexpr static bool is_lazy = is_lazy_<T>::value;
+}
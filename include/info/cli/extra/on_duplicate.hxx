@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Type modifier choosing what happens to repeated keys in associative
+ * containers.
+ */
+#pragma once
+
+namespace info::cli {
+    /**
+     * \brief What to do when a key is given again for an associative container
+     *
+     * Maps and sets are aggregated by inserting the parsed key (and value) into
+     * them; this decides the outcome if the key is already present. Unless
+     * chosen otherwise by on_duplicate, the behavior is \c overwrite.
+     */
+    enum class duplicate_key {
+        overwrite, ///< The value given last is kept, like for non-aggregating types
+        keep_first,///< The value given first is kept, later ones are dropped silently
+        reject,    ///< Repeating a key is an error reported as a callback_error
+    };
+
+    /**
+     * \brief A type modifier setting the duplicate_key policy of an associative container
+     *
+     * Created by on_duplicate, wraps the reference to the map or set to fill
+     * during parsing.
+     *
+     * \tparam Policy The duplicate_key policy to use
+     * \tparam T The associative container type to modify
+     */
+    template<duplicate_key Policy, class T>
+    struct on_duplicate_ {
+        T& value;///< The reference to the original variable to modify during parsing
+    };
+
+    /**
+     * \brief Sets the duplicate_key policy for an associative container callback
+     *
+     * \verbatim
+     * 'D'_opt >>= cli::on_duplicate<cli::duplicate_key::reject>(defines)
+     * \endverbatim
+     *
+     * \tparam Policy The duplicate_key policy to use
+     * \tparam T The associative container type
+     *
+     * \param ref The container to fill during parsing
+     *
+     * \return The type modifier wrapping \c ref
+     */
+    template<duplicate_key Policy, class T>
+    on_duplicate_<Policy, T>
+    on_duplicate(T& ref) noexcept {
+        return {ref};
+    }
+}
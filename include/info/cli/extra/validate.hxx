@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Attaching validators to options, which are run after parsing is done.
+ */
+#pragma once
+
+#include <exception>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <info/cli/macros.hxx>
+
+namespace info::cli {
+    /**
+     * \brief A validator waiting to be attached to a callback value
+     *
+     * Created by validate, and attached to the right hand side of the DSL's
+     * \c >>= operator with \c |.
+     *
+     * \tparam Fn The type of the validating functor
+     */
+    template<class Fn>
+    struct validate_ {
+        Fn fn;///< The functor checking the values
+    };
+
+    /**
+     * \brief A callback value with a validator attached
+     *
+     * The result of \c value|validate(fn), which is handled by the DSL as if
+     * only \c value were given, but the created option also carries the
+     * validator.
+     *
+     * \tparam T The type of the callback value; an lvalue reference for variables
+     * \tparam Fn The type of the validating functor
+     */
+    template<class T, class Fn>
+    struct validated_ {
+        T value;///< The callback value, variable reference, type modifier, or functor
+        Fn fn;  ///< The functor checking the values
+    };
+
+    /**
+     * \brief Creates a validator for use in the DSL
+     *
+     * Validators check the values of an option given on the command line, but
+     * unlike the callbacks, they are not run during parsing. The values of the
+     * options with validators are collected, and once the command line is
+     * parsed, they are checked concurrently on a pool of threads. Every failure
+     * is reported at once, by a validation_error. This makes them suitable for
+     * expensive checks, like whether the file given exists.
+     *
+     * The functor is called with the value as it was on the command line, and
+     * either returns a \c bool, \c false meaning the value is invalid,
+     * or something convertible to \c std::string, which is the reason the
+     * value is invalid, or empty if it is valid. If it throws an
+     * \c std::exception, its \c what() is the reason of the failure.
+     * The functor is called concurrently from multiple threads, so it must be
+     * safe to do so.
+     *
+     * \verbatim
+     * 'i'_opt >>= inputs | cli::validate(is_readable)
+     * \endverbatim
+     *
+     * \tparam Fn The type of the validating functor
+     *
+     * \param fn The functor checking the values
+     *
+     * \return The validator to attach to the callback value with \c |
+     */
+    template<class Fn>
+    validate_<std::decay_t<Fn>>
+    validate(Fn&& fn) {
+        return {std::forward<Fn>(fn)};
+    }
+
+    /**
+     * \brief Attaches a validator to a callback value
+     *
+     * Multiple validators can be attached to the same value, they are run
+     * in the order of attachment, until one of them fails.
+     *
+     * \tparam T The type of the callback value
+     * \tparam Fn The type of the validating functor
+     *
+     * \param value The callback value, as it would be given to the DSL's \c >>= operator
+     * \param val The validator created by validate
+     *
+     * \return The callback value with the validator attached
+     */
+    template<class T, class Fn>
+    validated_<T, Fn>
+    operator|(T&& value, validate_<Fn> val) {
+        return {std::forward<T>(value), std::move(val.fn)};
+    }
+}
+
+namespace info::_cli {
+    /// \cond DOXYGEN_IGNORE_THIS
+    template<class T>
+    struct is_validated_ : std::false_type { };
+
+    template<class T, class Fn>
+    struct is_validated_<cli::validated_<T, Fn>> : std::true_type { };
+    /// \endcond
+
+    /**
+     * \brief Whether the type is a callback value with a validator attached
+     *
+     * \tparam T The type to check
+     */
+    template<class T>
+    constexpr static bool is_validated = is_validated_<T>::value;
+
+    /**
+     * \brief Creates the type-erasable validator from the user's functor
+     *
+     * The created functor returns the reason the value is invalid, or the
+     * empty string, for any of the return types validate accepts. Exceptions
+     * do not leave it, as it is called on worker threads.
+     *
+     * \tparam Fn The type of the validating functor
+     *
+     * \param fn The functor checking the values
+     *
+     * \return The functor returning the reason of invalidity
+     */
+    template<class Fn>
+    auto
+    make_validator(Fn fn) {
+        return [fn = std::move(fn)](std::string_view value) -> std::string {
+            try {
+                if constexpr (std::is_convertible_v<std::invoke_result_t<const Fn&, std::string_view>,
+                                                    std::string>) {
+                    return fn(value);
+                } else {
+                    return fn(value) ? std::string{}
+                                     : std::string("rejected by validator");
+                }
+            } catch (const std::exception& ex) {
+                return ex.what();
+            } catch (...) {
+                return "validator failed with an unknown exception";
+            }
+        };
+    }
+}
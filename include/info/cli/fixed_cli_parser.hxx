@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * A cli_parser variant which keeps all of its storage inside the object.
+ */
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+
+#include <info/cli/cli_parser.hxx>
+
+namespace info::_cli {
+    /**
+     * \brief The in-object storage of a fixed_cli_parser
+     *
+     * A base class of fixed_cli_parser, so that it is initialized before
+     * the cli_parser base which allocates from it. The resources never fall
+     * back to the heap: running out of storage throws \c std::bad_alloc.
+     *
+     * \tparam Bytes The size of the storage for the parser's tables
+     * \tparam MaxOperands The amount of operands stored
+     */
+    template<std::size_t Bytes, std::size_t MaxOperands>
+    struct fixed_storage {
+        alignas(std::max_align_t) std::byte table_buffer[Bytes];
+        alignas(std::string_view) std::byte operand_buffer[MaxOperands * sizeof(std::string_view)];
+
+        std::pmr::monotonic_buffer_resource table_resource{table_buffer,
+                                                           sizeof(table_buffer),
+                                                           std::pmr::null_memory_resource()};
+        std::pmr::monotonic_buffer_resource operand_resource{operand_buffer,
+                                                             sizeof(operand_buffer),
+                                                             std::pmr::null_memory_resource()};
+    };
+}
+
+namespace info::cli {
+    /**
+     * \brief The default amount of bytes reserved for the tables of a fixed_cli_parser
+     *
+     * Enough for options with a short and a long name and a shorter help text,
+     * options with many aliases or long help texts may need more.
+     *
+     * \param max_options The maximal amount of options the parser is created with
+     *
+     * \return The size of the storage in bytes
+     */
+    constexpr std::size_t
+    fixed_parser_bytes(std::size_t max_options) noexcept {
+        return 1024 + 512 * max_options;
+    }
+
+    /**
+     * \brief A cli_parser which does not use the heap
+     *
+     * A cli_parser that allocates its tables, and the operands returned by
+     * parsing, from buffers inside the object itself. This makes it usable
+     * where the heap is not available, or must not be touched after
+     * startup: the object can be a global, or live on the stack.
+     *
+     * Options and operands beyond the limits are not silently dropped:
+     * if the tables do not fit in \c Bytes the constructor, if there are more
+     * than \c MaxOperands operands parsing throws \c std::bad_alloc.
+     *
+     * The same limitations apply as for cli_parser constructed with a memory
+     * resource: exceptions, the Auto-Help, and callbacks too large for
+     * \c std::function's small-object buffer still use the heap.
+     *
+     * \tparam MaxOptions The maximal amount of options the parser is created with
+     * \tparam MaxOperands The maximal amount of operands returned from a parse
+     * \tparam Bytes The size of the storage for the parser's tables
+     */
+    template<std::size_t MaxOptions,
+             std::size_t MaxOperands,
+             std::size_t Bytes = fixed_parser_bytes(MaxOptions)>
+    struct fixed_cli_parser : private _cli::fixed_storage<Bytes, MaxOperands>,
+                              public cli_parser {
+        /**
+         * \brief Create the fixed_cli_parser with the given options
+         *
+         * \throws std::length_error if more than \c MaxOptions options are given
+         * \throws std::bad_alloc if the options do not fit into the storage
+         *
+         * \param opts The set of options to handle during parsing
+         */
+        fixed_cli_parser(std::initializer_list<option> opts)
+             : cli_parser((check_size(opts.size()), opts), &this->table_resource) { }
+
+        fixed_cli_parser(const fixed_cli_parser&) = delete;
+        fixed_cli_parser& operator=(const fixed_cli_parser&) = delete;
+
+        /**
+         * \brief Calls the parsing logic for the defined options
+         *
+         * \warning The returned vector lives in the parser's storage,
+         * it is only valid until the next parse with the same parser.
+         *
+         * \throws std::bad_alloc if there are more than \c MaxOperands operands
+         *
+         * \param argc The number of strings in \c argv
+         * \param argv An array of C-strings as given to the program through main
+         *
+         * \return A vector of string_views containing the operands in order of encounter
+         */
+        std::pmr::vector<std::string_view>
+        operator()(std::size_t argc, char** argv) {
+            this->operand_resource.release();
+            std::pmr::vector<std::string_view> operands(&this->operand_resource);
+            operands.reserve(MaxOperands);
+            parse(argc, argv, operand_sink(operands));
+            return operands;
+        }
+
+        /**
+         * \copydoc operator()(std::size_t,char**)
+         */
+        std::pmr::vector<std::string_view>
+        operator()(int argc, char** argv) {
+            return (*this)(static_cast<std::size_t>(argc), argv);
+        }
+
+    private:
+        static void
+        check_size(std::size_t options) {
+            if (options > MaxOptions) {
+                throw std::length_error("more options given to fixed_cli_parser than its MaxOptions");
+            }
+        }
+    };
+}
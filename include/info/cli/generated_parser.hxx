@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * The parsing loop shared by the parsers emitted by infocli-gen, the offline
+ * parser generator of InfoCLI.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/exc/callback_error.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+#include <info/cli/macros.hxx>
+#include <info/cli/option.hxx>
+#include <info/cli/types/type_data.hxx>
+
+namespace info::_cli {
+    /**
+     * \brief An option of a generated parser, as it is listed in the help
+     */
+    struct generated_help_entry {
+        std::string_view help;       ///< The help text of the option
+        const std::string_view* names;///< The names of the option, in the order of the schema
+        std::size_t name_count;      ///< The number of names
+        std::size_t id;              ///< The id of the option, indexing the types of the parser
+    };
+
+    /**
+     * \brief The help of a generated parser
+     *
+     * The usage line is precomputed by the generator, the options are only
+     * formatted when printed, as the names of the types are only known to
+     * the compiler.
+     */
+    struct generated_help {
+        std::string_view usage_options;      ///< The options part of the usage line, as cli_parser::usage_options
+        const generated_help_entry* entries;///< The documented options
+        std::size_t entry_count;            ///< The number of documented options
+        const cli::rt_type_data* types;     ///< The types of the options, by id
+    };
+
+    /**
+     * \brief Prints the help of a generated parser, then exits
+     *
+     * Prints the same layout as cli_parser's Auto-Help.
+     *
+     * \param help The help of the generated parser
+     * \param exec The name of the executable, for the usage line
+     */
+    [[noreturn]] INFO_CLI_API void
+    print_generated_help(const generated_help& help, std::string_view exec);
+
+    /**
+     * \brief The hash of an option name in the perfect hash table of a generated parser
+     *
+     * FNV-1a, with the offset basis perturbed by the seed the generator found
+     * the table with. The low bits select the bucket of the name.
+     *
+     * \param name The name of the option, without dashes
+     * \param seed The seed of the table
+     *
+     * \return The hash of the name
+     */
+    constexpr std::uint32_t
+    generated_hash(std::string_view name, std::uint32_t seed) noexcept {
+        std::uint32_t h = 2166136261u ^ seed;
+        for (char c : name) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    /**
+     * \brief The slot of a hash in the perfect hash table of a generated parser
+     *
+     * Mixes the hash with the displacement of its bucket, with the finalizer
+     * of MurmurHash3, so every bit of the hash affects the slot.
+     *
+     * \param hash The hash of the name, as returned by generated_hash
+     * \param displacement The displacement of the bucket of the hash
+     *
+     * \return The slot before masking it to the size of the table
+     */
+    constexpr std::uint32_t
+    generated_slot(std::uint32_t hash, std::uint32_t displacement) noexcept {
+        std::uint32_t h = hash ^ displacement;
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    /**
+     * \brief Returns the runtime type information of a type, as a constant expression
+     *
+     * The same as what the DSL stores for an option of the type, so the
+     * tables of generated parsers can be initialized at compile time.
+     *
+     * \tparam T The type as given in the schema, possibly a type modifier
+     *
+     * \return The runtime type information of the type
+     */
+    template<class T>
+    constexpr cli::rt_type_data
+    generated_type() noexcept {
+        using data = cli::type_data<cli::meta::expected_type<T>>;
+        return {data::allow_nothing,
+                data::default_value,
+                data::length,
+                data::expected_type,
+                data::type_name};
+    }
+
+    /**
+     * \brief The parsing loop of the parsers emitted by infocli-gen
+     *
+     * Parses the command line with the same rules as cli_parser::operator()
+     * does, with the unknown option behavior being unknown_behavior::classic,
+     * but the options are looked up in the perfect hash table of the
+     * generated parser, and their values are parsed straight into its
+     * members, without going through type-erased callbacks.
+     *
+     * The generated parser provides the following:
+     *  - <tt>static int find(std::string_view name) noexcept</tt>: the id of
+     *    the option with the name, or \c -1
+     *  - <tt>static const info::cli::rt_type_data types[]</tt>: the types of
+     *    the options, by id
+     *  - <tt>static constexpr int help_id</tt>: the id of the Auto-Help, or \c -1
+     *  - <tt>static const info::_cli::generated_help help</tt>: the help
+     *  - <tt>bool store(int id, std::string_view value, const char*& last)</tt>:
+     *    parses the value into the member of the option
+     *
+     * \tparam Parser The generated parser
+     *
+     * \throws no_such_option if an option not in the schema is given
+     * \throws bad_option_value if an option is not given its value
+     * \throws callback_error if the value of an option cannot be parsed
+     *
+     * \param parser The generated parser to store the values in
+     * \param argc The number of strings in \c argv
+     * \param argv An array of C-strings as given to the program through main
+     *
+     * \return The operands in order of encounter
+     */
+    template<class Parser>
+    std::vector<std::string_view>
+    generated_parse(Parser& parser, std::size_t argc, char** argv) {
+        std::vector<std::string_view> operands;
+        operands.reserve(argc);
+
+        std::string_view exec;
+        if (argc > 0) {
+#ifdef _WIN32
+            constexpr const auto separators = "\\/";
+#else
+            constexpr const auto separators = "/";
+#endif
+            exec = argv[0];
+            exec.remove_prefix(exec.find_last_of(separators) + 1);// npos + 1 == 0
+        }
+
+        const char* last = nullptr;
+        auto call = [&](int id, std::string_view name, std::string_view value) {
+            if (id == Parser::help_id) {
+                print_generated_help(Parser::help, exec);
+            }
+            last = nullptr;
+            if (!parser.store(id, value, last)) {
+                throw cli::callback_error(std::string(name), std::string(value));
+            }
+        };
+        auto value_or_next = [&](int id, std::string_view name, std::size_t& i) {
+            const auto& data = Parser::types[id];
+            if (data.allow_nothing) {
+                call(id, name, data.default_val);
+                return;
+            }
+            if (i + 1 == argc) {
+                throw cli::bad_option_value(std::string(name), data.type_name, "<none given>");
+            }
+            ++i;
+            call(id, name, parsing::value_of(data, argv[i]));
+        };
+
+        for (std::size_t i = 0; i != argc; ++i) {
+            std::string_view arg = argv[i];
+            if (arg.size() < 2 || arg[0] != '-') {// operand or "-"
+                operands.push_back(arg);
+                continue;
+            }
+
+            if (arg[1] == '-') {
+                if (arg.size() == 2) {// "--"
+                    operands.insert(operands.end(), argv + i + 1, argv + argc);
+                    break;
+                }
+
+                auto name = arg.substr(2);
+                if (auto eq = name.find('=');
+                    eq != std::string_view::npos) {// GNU-style long options
+                    auto id = Parser::find(name.substr(0, eq));
+                    if (id < 0) {
+                        throw cli::no_such_option(std::string(name));
+                    }
+                    call(id, name.substr(0, eq), name.substr(eq + 1));
+                    continue;
+                }
+
+                auto id = Parser::find(name);
+                if (id < 0) {
+                    throw cli::no_such_option(std::string(name));
+                }
+                value_or_next(id, name, i);
+                continue;
+            }
+
+            auto rest = arg.substr(1);
+            while (!rest.empty()) {
+                auto name = rest.substr(0, 1);
+                auto id = Parser::find(name);
+                if (id < 0) {
+                    throw cli::no_such_option(std::string(arg.substr(1)));
+                }
+                const auto& data = Parser::types[id];
+                rest.remove_prefix(1);
+
+                if (rest.empty()) {// short unpacked option
+                    value_or_next(id, name, i);
+                    break;
+                }
+                if (data.allow_nothing
+                    && Parser::find(rest.substr(0, 1)) >= 0) {// the next is an option as well
+                    call(id, name, data.default_val);
+                    continue;
+                }
+                if (parsing::accepts(data.expected_type, rest[0])) {// munch from the group
+                    call(id, name, parsing::value_of(data, rest));
+
+                    auto end = rest.data() + rest.size();
+                    if (last == nullptr || last < rest.data() || last >= end) {// the end is here, or the parser did not tell
+                        break;
+                    }
+                    rest.remove_prefix(static_cast<std::size_t>(last - rest.data()));
+                    continue;
+                }
+                if (data.allow_nothing) {
+                    call(id, name, data.default_val);
+                    break;
+                }
+                throw cli::bad_option_value(std::string(name), data.type_name, "<none given>");
+            }
+        }
+        return operands;
+    }
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../src/generated_parser.cxx"
+#endif
@@ -32,7 +32,8 @@
 #endif
 
 // dll im-/export
-#if !INFO_CLI_BUILD_STATIC \
+#if !INFO_CLI_BUILD_STATIC                 \
+       && !INFO_CLI_HEADER_ONLY            \
        && !defined(INFO_CLI_DOXYGEN_RUN)
 #    if defined(_WIN32) || defined(__CYGWIN__)
 #        if INFO_CLI_EXPORTS
@@ -72,6 +73,21 @@
 #    define INFO_CLI_LOCAL
 #endif
 
+/**
+ * \brief Macro marking the definitions of the library's source files
+ *
+ * When InfoCLI is used header-only, by defining \c INFO_CLI_HEADER_ONLY to 1,
+ * the headers include the source files, so the compiler sees every definition
+ * and can inline them into the callbacks, eg. the type_parser-s. The
+ * definitions in the source files are then marked \c inline by this macro,
+ * otherwise it expands to nothing.
+ */
+#if INFO_CLI_HEADER_ONLY
+#    define INFO_CLI_INLINE inline
+#else
+#    define INFO_CLI_INLINE
+#endif
+
 /**
  * \brief Macro for marking impossible execution paths
  *
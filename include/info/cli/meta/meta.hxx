@@ -181,6 +181,33 @@ namespace info::cli::meta {
         using type = cli::repeat<T>;///< The return type
     };
 
+    /**
+     * \copybrief expected_type_
+     *
+     * The on_duplicate type modifier does not change the type information,
+     * so that is the one of the wrapped container.
+     *
+     * \tparam Policy The duplicate_key policy of the modifier
+     * \tparam T The modified type
+     */
+    template<cli::duplicate_key Policy, class T>
+    struct INFO_CLI_LOCAL expected_type_<cli::on_duplicate_<Policy, T>> {
+        using type = T;///< The return type
+    };
+
+    /**
+     * \copybrief expected_type_
+     *
+     * The lazy type modifier keeps itself, so that its type_data can tell the
+     * value is taken whole.
+     *
+     * \tparam T The type of the lazy value
+     */
+    template<class T>
+    struct INFO_CLI_LOCAL expected_type_<cli::lazy<T>> {
+        using type = cli::lazy<T>;///< The return type
+    };
+
     /**
      * \brief A meta-function that returns the type that's to be used by
      *         InfoRTTI during runtime
@@ -226,6 +253,19 @@ namespace info::cli::meta {
         using type = std::add_lvalue_reference_t<T>;
     };
 
+    /**
+     * \copybrief referenced_type_
+     *
+     * Strips the on_duplicate type modifier.
+     *
+     * \tparam Policy The duplicate_key policy of the modifier
+     * \tparam T The type engulfed by the type modifier
+     */
+    template<cli::duplicate_key Policy, class T>
+    struct INFO_CLI_LOCAL referenced_type_<cli::on_duplicate_<Policy, T>> {
+        using type = std::add_lvalue_reference_t<T>;
+    };
+
     /**
      * \brief A meta-function that returns the lvalue reference type that's
      *         actually given by the user
@@ -7,13 +7,13 @@
  */
 #pragma once
 
-#include <deque>
 #include <functional>
 #include <string>
 #include <type_traits>
 #include <vector>
 
 #include <info/cli/aggregator.hxx>
+#include <info/cli/extra/validate.hxx>
 #include <info/cli/meta/dissector.hxx>
 #include <info/cli/types/type_data.hxx>
 #include <info/cli/types/type_modifier.hxx>
@@ -36,6 +36,20 @@ namespace info::_cli {
 }
 
 namespace info::cli {
+    /**
+     * \brief What an option takes from the operands of the command line
+     *
+     * Options made with the \c _opt literals are named, and only get the
+     * values given to them by name. Operand slots, made with cli::operand and
+     * cli::operands, have no name on the command line, and instead receive
+     * the operands in the order they are found.
+     */
+    enum class operand_kind {
+        none,  ///< A named option, not an operand slot
+        single,///< An operand slot taking the next operand
+        rest   ///< An operand slot taking every remaining operand
+    };
+
     /**
      * \brief The struct used do define options in the DSL.
      *
@@ -63,6 +77,20 @@ namespace info::cli {
          * for when an option is encountered.
          */
         using callback_type = bool(std::string_view, const char*&);
+        /**
+         * \brief Type of the function reserving room in aggregating callbacks
+         *
+         * Called with the amount of times the option is going to be seen,
+         * before the callback is called for any of them.
+         */
+        using reserve_type = void(std::size_t);
+        /**
+         * \brief Type of the validators of options
+         *
+         * Called with the value of the option after parsing, returns the
+         * reason the value is invalid, or the empty string if it is valid.
+         */
+        using validator_type = std::string(std::string_view);
 
         /**
          * \brief Creates an option object which defines an cli option
@@ -76,16 +104,21 @@ namespace info::cli {
          * \param callback A function of callback_type which is used to perform the callback
          * \param names The name and the aliases of the option. The first value is considered the name
          * \param type The InfoRTTI type info for the type associated with the created option
+         * \param reserve A function of reserve_type, if the callback aggregates into a reservable container
          */
         option(std::string help,
                std::function<callback_type> callback,
                std::vector<std::string>&& names,
-               rt_type_data type);
+               rt_type_data type,
+               std::function<reserve_type> reserve = {});
 
         std::vector<std::string> names;       ///< The name and the aliases for this option
         rt_type_data type;                    ///< InfoRTTI type info for the type associated with this option
         std::string help;                     ///< The Auto-Help description
         std::function<callback_type> callback;///< The callback used when the option is encountered
+        std::function<reserve_type> reserve;  ///< Reserves room for the values of the callback, may be empty
+        std::function<validator_type> validator;///< Checks the values after parsing, may be empty
+        operand_kind operand = operand_kind::none;///< Whether this is an operand slot, and which kind
     };
 
     /**
@@ -137,6 +170,54 @@ namespace info::cli {
 }
 
 namespace info::_cli {
+    /**
+     * \brief Parses a value and stores it into a variable, as the DSL's callbacks do
+     *
+     * Calls the type_parser of the type, then aggregates the value into the
+     * variable as the aggregator_ of the type dictates, or if it cannot be
+     * aggregated, assigns it. This is the body of the callbacks created for
+     * variable references, also used by the parsers emitted by infocli-gen.
+     *
+     * \tparam T The decayed type of the callback value, possibly a type modifier
+     *
+     * \param ref The variable to store the value into, as returned by type_modifier_
+     * \param str The string to parse the value from
+     * \param last Set to one past the last character the type_parser consumed
+     *
+     * \return Whether the value was accepted, or was ignored by the type_parser
+     */
+    template<class T>
+    bool
+    parse_into(cli::meta::referenced_type<T>& ref, std::string_view str, const char*& last) {
+        // The type to which we have a reference to; usually T, but
+        // modifiers may change it to something else
+        // eg. T = repeat<U> => ReferencedType = U
+        using ReferencedType = cli::meta::referenced_type<T>;
+        // The type to parse from a string. This changes for stdlib containers
+        // and modifiers for example, otherwise is just T
+        using ParsedType = aggregator_type<T>;
+
+        auto val = cli::type_parser<ParsedType>{}(str, last);
+        if (!val) {
+            return val.error() == cli::parser_opcode::ignore;
+        }
+
+        if constexpr (_cli::aggregator<T>) {
+            if constexpr (std::is_move_constructible_v<ReferencedType>) {
+                return _cli::aggregate<T>(ref, std::move(*val));
+            } else {
+                return _cli::aggregate<T>(ref, *val);
+            }
+        } else {
+            if constexpr (std::is_move_assignable_v<ReferencedType>) {
+                ref = std::move(*val);
+            } else {
+                ref = *val;
+            }
+        }
+        return true;
+    }
+
     /**
      * \brief An option-builder that has a help message an now only needs
      * the callback to finish the option.
@@ -145,6 +226,14 @@ namespace info::_cli {
      * and also has a help-text. The only way from here is the callback with >>=.
      */
     struct INFO_CLI_API helpful_option_builder {
+        /**
+         * \brief Constructs a helpful_option_builder without names and help
+         *
+         * Used to create only the callback of an option, the way the DSL
+         * would, without naming an option, see cli::make_callback.
+         */
+        helpful_option_builder() = default;
+
         /**
          * \brief Constructs a helpful_option_builder by advancing the option_builder
          *         without a help description
@@ -162,6 +251,13 @@ namespace info::_cli {
          *             description.
          */
         explicit helpful_option_builder(const option_builder& bld);
+        /**
+         * \copydoc helpful_option_builder(const option_builder&)
+         *
+         * The names are moved out of the expiring option_builder, instead
+         * of being copied.
+         */
+        explicit helpful_option_builder(option_builder&& bld);
         /**
          * \brief Takes the names from the option_builder and advances the build
          *         procedure with the help description.
@@ -175,6 +271,13 @@ namespace info::_cli {
          * \param bld The previous step's builder, which contains the option's name and aliases
          */
         helpful_option_builder(std::string_view help, const option_builder& bld);
+        /**
+         * \copydoc helpful_option_builder(std::string_view,const option_builder&)
+         *
+         * The names are moved out of the expiring option_builder, instead
+         * of being copied.
+         */
+        helpful_option_builder(std::string_view help, option_builder&& bld);
 
         /**
          * \brief Creates the option from the builder by defining the callback
@@ -199,50 +302,37 @@ namespace info::_cli {
                  typename std::enable_if<
                     !cli::meta::is_typed_callback<std::decay_t<T>>
                     && !std::is_invocable_v<T, std::string_view>
+                    && !_cli::is_validated<std::decay_t<T>>
                  >::type* = nullptr
         >// clang-format on
         cli::option
         operator>>=(T&& ref) {// Reference to variable
             // The type without reference stuffs
             using DecayedType = std::decay_t<T>;
-            // The type to which we have a reference to; usually DecayedType, but
-            // modifiers may change it to something else
-            // eg. DecayedType = repeat<T> => ReferencedType = T
-            using ReferencedType = cli::meta::referenced_type<DecayedType>;
             // The type that's to be used for the type_data. In most cases
-            // it is ParsedType, except for modifiers where it is DecayedType,
+            // it is the parsed type, except for modifiers where it is DecayedType,
             // because type_data tracks changes with modifiers, so it needs to
             // know about them
             using ExpectedType = cli::meta::expected_type<DecayedType>;
-            // The type to parse from a string. This changes for stdlib containers
-            // and modifiers for example, otherwise is just DecayedType
-            using ParsedType = aggregator_type<DecayedType>;
 
             auto& rf = cli::type_modifier_<T>{}(ref);
+            if constexpr (_cli::is_lazy<DecayedType>) {
+                rf.option_name(names.front());
+            }
 
-            return {help, [&rf](std::string_view str, const char*& last) {
-                        auto val = cli::type_parser<ParsedType>{}(str, last);
-                        if (!val) {
-                            return val.error() == cli::parser_opcode::ignore;
-                        }
+            std::function<cli::option::reserve_type> reserve;
+            if constexpr (_cli::is_reservable<DecayedType>) {
+                reserve = [&rf](std::size_t n) {
+                    _cli::aggregator<DecayedType>.reserve(rf, n);
+                };
+            }
 
-                        if constexpr (auto agg = _cli::aggregator<DecayedType>) {
-                            if constexpr (std::is_move_constructible_v<ReferencedType>) {
-                                agg(rf, std::move(*val));
-                            } else {
-                                agg(rf, *val);
-                            }
-                        } else {
-                            if constexpr (std::is_move_assignable_v<ReferencedType>) {
-                                rf = std::move(*val);
-                            } else {
-                                rf = *val;
-                            }
-                        }
-                        return true;
+            return {help, [&rf](std::string_view str, const char*& last) {
+                        return _cli::parse_into<DecayedType>(rf, str, last);
                     },
                     std::move(names),
-                    cli::rt_type_data(cli::type_data<ExpectedType>{})};
+                    cli::rt_type_data(cli::type_data<ExpectedType>{}),
+                    std::move(reserve)};
         }
 
         /**
@@ -282,12 +372,16 @@ namespace info::_cli {
                             return val.error() == cli::parser_opcode::ignore;
                         }
 
-                        if constexpr (auto agg = _cli::aggregator<T>) {
+                        if constexpr (_cli::aggregator<T>) {
                             T ref;
+                            bool accepted;
                             if constexpr (std::is_move_constructible_v<typ>) {
-                                agg(ref, std::move(*val));
+                                accepted = _cli::aggregate<T>(ref, std::move(*val));
                             } else {
-                                agg(ref, *val);
+                                accepted = _cli::aggregate<T>(ref, *val);
+                            }
+                            if (!accepted) {
+                                return false;
                             }
                             fn(ref);
                         } else {
@@ -344,6 +438,37 @@ namespace info::_cli {
                     cli::rt_type_data(cli::type_data<ret>())};
         }
 
+        /**
+         * \copybrief operator>>=(T&&)
+         *
+         * Creates the option for the callback value the validator is attached
+         * to, as if it were given without one, and then adds the validator to
+         * the created option. See cli::validate.
+         *
+         * \tparam T The type of the callback value
+         * \tparam Fn The type of the validating functor
+         * \param val The callback value with the validator attached
+         * \return The option constructed by the stored name, aliases, help,
+         *          the callback, and the validator.
+         */
+        template<class T, class Fn>
+        cli::option
+        operator>>=(cli::validated_<T, Fn> val) {// validated callback value
+            auto opt = (*this >>= std::forward<T>(val.value));
+            auto validator = _cli::make_validator(std::move(val.fn));
+            if (opt.validator) {// chained: the earlier ones go first
+                opt.validator = [first = std::move(opt.validator),
+                                 second = std::move(validator)](std::string_view value) {
+                    auto reason = first(value);
+                    return reason.empty() ? second(value)
+                                          : reason;
+                };
+            } else {
+                opt.validator = std::move(validator);
+            }
+            return opt;
+        }
+
         std::string help;              ///< The help description for Auto-Help. May be the empty string
         std::vector<std::string> names;///< The name and aliases of the created option
     };
@@ -386,7 +511,9 @@ namespace info::_cli {
          *
          * \return An object that is used to create the finished option
          */
-        helpful_option_builder operator>=(std::string_view help);
+        helpful_option_builder operator>=(std::string_view help) const&;
+        /// \copydoc operator>=(std::string_view) const&
+        helpful_option_builder operator>=(std::string_view help) &&;
 
         /**
          * \brief Create the option object without help description
@@ -410,13 +537,22 @@ namespace info::_cli {
          */
         template<class Callback>
         cli::option
-        operator>>=(Callback&& callback) {
+        operator>>=(Callback&& callback) const& {
             // delegate all the work to the helpful
             return (helpful_option_builder(*this)).operator>>=(std::forward<Callback>(callback));
         }
 
-        // deque: need access to push_front
-        std::deque<std::string> names;///< The names that are aliased for the current option
+        /// \copydoc operator>>=(Callback&&) const&
+        template<class Callback>
+        cli::option
+        operator>>=(Callback&& callback) && {
+            // the builder expires here, so the names can be moved along
+            return (helpful_option_builder(std::move(*this))).operator>>=(std::forward<Callback>(callback));
+        }
+
+        // vector: the names move along the build steps into the option as is;
+        // prepending to the few names an option has is cheap enough
+        std::vector<std::string> names;///< The names that are aliased for the current option
     };
 
     /**
@@ -450,4 +586,124 @@ namespace info::_cli {
      * \return An option_builder instance containing all the aliases to the primer option
      */
     INFO_CLI_API option_builder operator/(option_builder bld1, const option_builder& bld2);
+    /// \copydoc operator/(option_builder,const option_builder&)
+    INFO_CLI_API option_builder operator/(option_builder bld1, option_builder&& bld2);
+
+    /**
+     * \brief Builder object used by the DSL to create operand slots.
+     *
+     * Created by cli::operand and cli::operands, it works the same as the
+     * option_builder, except it cannot have aliases, as an operand slot is
+     * not matched by name. The name is only used by Auto-Help and in errors.
+     */
+    struct INFO_CLI_API operand_builder {
+        /**
+         * \brief Constructs an operand_builder for an operand slot
+         *
+         * \param name The name of the operand slot for Auto-Help
+         * \param kind Whether the slot takes one, or all the remaining operands
+         */
+        operand_builder(std::string_view name, cli::operand_kind kind);
+
+        /**
+         * \brief Adds help description to the operand slot being built
+         *
+         * \param help The description to use in the help generated by Auto-Help
+         *
+         * \return This builder, with the help description
+         */
+        operand_builder operator>=(std::string_view help) &&;
+
+        /**
+         * \brief Create the operand slot with the given callback
+         *
+         * The callback is created as it would be for an option, so it parses
+         * the operands with the type_parser of the callback value, and
+         * aggregates them, as dictated by its aggregator_. See
+         * helpful_option_builder::operator>>=.
+         *
+         * \tparam Callback The type of the callback to use.
+         * \param callback The callback to use for this operand slot
+         * \return The built operand slot, as an option without names on the command line
+         */
+        template<class Callback>
+        cli::option
+        operator>>=(Callback&& callback) && {
+            helpful_option_builder bld;
+            bld.help = std::move(help);
+            bld.names.push_back(std::move(name));
+            auto opt = (std::move(bld) >>= std::forward<Callback>(callback));
+            opt.operand = kind;
+            return opt;
+        }
+
+        std::string name;       ///< The name of the operand slot for Auto-Help
+        std::string help;       ///< The help description for Auto-Help. May be the empty string
+        cli::operand_kind kind; ///< Whether the slot takes one, or all the remaining operands
+    };
+}
+
+namespace info::cli {
+    /**
+     * \brief Creates the callback the DSL would create for the given callback value
+     *
+     * Takes anything that can stand on the right hand side of the \c >>=
+     * operator of the DSL, and returns the callback an option would use,
+     * without creating the rest of the option. This is used to relink the
+     * callbacks when loading a cli_parser from a snapshot.
+     *
+     * \tparam T The type of the callback value
+     * \param ref The variable reference, type modifier, or functor to create the callback for
+     *
+     * \return The callback to be called with the value found on the command line
+     */
+    template<class T>
+    std::function<option::callback_type>
+    make_callback(T&& ref) {
+        return (_cli::helpful_option_builder{} >>= std::forward<T>(ref)).callback;
+    }
+
+    /**
+     * \brief Starts the definition of an operand slot taking a single operand
+     *
+     * Operand slots receive the operands of the command line, instead of
+     * them being returned by the cli_parser. The slots are filled in the order
+     * they are given to the cli_parser, each single slot taking one
+     * operand, while the operands after the slots are returned as usual.
+     * The values are parsed with the type_parser of the callback value,
+     * while the command line is parsed.
+     *
+     * \verbatim
+     * int count;
+     * std::vector<double> samples;
+     * cli_parser cli{'v'_opt >>= verbose,
+     *                operand("count") >= "The amount of runs" >>= count,
+     *                operands("samples") >>= samples};
+     * \endverbatim
+     *
+     * \param name The name of the operand for Auto-Help and errors
+     *
+     * \return The builder of the operand slot, for the rest of the DSL
+     */
+    INFO_CLI_API _cli::operand_builder operand(std::string_view name);
+
+    /**
+     * \brief Starts the definition of an operand slot taking all remaining operands
+     *
+     * Same as cli::operand, but once the slot is reached, it takes all the
+     * operands that follow, so usually the callback value aggregates, like
+     * an \c std::vector. No operands are returned by the cli_parser after it.
+     *
+     * \param name The name of the operands for Auto-Help and errors
+     *
+     * \return The builder of the operand slot, for the rest of the DSL
+     */
+    INFO_CLI_API _cli::operand_builder operands(std::string_view name);
 }
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../src/option.cxx"
+#    include "../../../src/impl/option_builder.cxx"
+#    include "../../../src/impl/helpful_option_builder.cxx"
+#    include "../../../src/impl/operand_builder.cxx"
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines push_parser, the incremental interface of a cli_parser, which is
+ * given the arguments one by one, as they arrive.
+ */
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/macros.hxx>
+
+namespace info::cli {
+    /**
+     * \brief Parses the arguments of a cli_parser as they arrive
+     *
+     * Where cli_parser::operator() needs the whole command line up front,
+     * a push_parser is given the arguments one at a time, with push, or as
+     * raw bytes of NUL-terminated arguments, the way <tt>xargs -0</tt> writes
+     * them, with feed. Everything that is not complete yet is kept between
+     * calls: the incomplete argument of the bytes fed, an option still waiting
+     * for its value in the next argument, or a seen \c \-\- after which only
+     * operands follow. At the end of the input, finish must be called.
+     *
+     * The callbacks, operand slots, and validators of the cli_parser are run
+     * as each argument is completed, the same way as cli_parser::operator()
+     * would. The operands are given to the sink as they are found. Only the
+     * argument being completed is stored, thus memory use is bounded by the
+     * longest argument, not by the length of the input. Unlike in \c argv,
+     * the first argument is not taken to be the program name.
+     *
+     * \verbatim
+     * cli::push_parser push(cli, [](std::string_view op) { process(op); });
+     * while (auto n = read(fd, buf, sizeof buf)) {
+     *     push.feed({buf, n});
+     * }
+     * push.finish();
+     * \endverbatim
+     *
+     * \warning The arguments are not kept after they are parsed, so the
+     * string_views given to the callbacks and the sink are only valid during
+     * the call. Callback values which keep views, like \c std::string_view
+     * variables and lazy values, must not be used with a push_parser.
+     *
+     * \note The cli_parser may only be used by one push_parser at a time,
+     * and not with operator() during that. Presizing is not done, as the
+     * amount of arguments is not known.
+     */
+    class INFO_CLI_API push_parser {
+    public:
+        /// The type of the sink receiving the operands
+        using sink_type = std::function<void(std::string_view)>;
+
+        /**
+         * \brief Starts an incremental parse with the given parser
+         *
+         * \param parser The parser whose options are parsed; must outlive the push_parser
+         * \param sink The callable given each operand, in order of encounter
+         */
+        push_parser(cli_parser& parser, sink_type sink);
+
+        push_parser(const push_parser&) = delete;
+        push_parser& operator=(const push_parser&) = delete;
+
+        /// Lets the cli_parser be used by operator(), or another push_parser
+        ~push_parser();
+
+        /**
+         * \brief Parses a complete argument
+         *
+         * If feed left an incomplete argument, it is completed by \c arg.
+         * If an earlier call threw with arguments left to parse, those are
+         * parsed first.
+         *
+         * \throws Anything cli_parser::operator() throws for the argument
+         *
+         * \param arg The argument, as it would be in \c argv
+         */
+        void push(std::string_view arg);
+
+        /**
+         * \brief Parses the arguments completed by the given bytes
+         *
+         * The bytes are a chunk of the arguments, each terminated by a NUL
+         * character. Every argument completed by the chunk is pushed, and the
+         * incomplete one at its end is kept, until completed by the next chunk.
+         * The chunks may be split anywhere.
+         *
+         * If an argument throws, it is dropped, and the arguments after it in
+         * the chunk are kept, and parsed before the input of the next call.
+         *
+         * \throws Anything cli_parser::operator() throws for the arguments
+         *
+         * \param bytes The next chunk of NUL-terminated arguments
+         */
+        void feed(std::string_view bytes);
+
+        /**
+         * \brief Ends the input, and resets to parse another one
+         *
+         * Parses the arguments left by an earlier error, then pushes the
+         * argument left incomplete by feed, if any, as if it were terminated. If an option is still waiting for its value, throws the
+         * same way cli_parser::operator() does, if the command line ends there.
+         *
+         * \throws bad_option_value if an option is left without its value
+         * \throws constraint_error if the options given violate the constraints of the parser
+         */
+        void finish();
+
+        /**
+         * \brief Whether an option is waiting for its value in the next argument
+         *
+         * \return Whether the last argument pushed needs a value after it
+         */
+        [[nodiscard]] bool awaiting_value() const noexcept;
+
+    private:
+        cli_parser& _parser;
+        sink_type _sink;
+        std::string _arg;///< The argument being completed, reused to keep its capacity
+        std::string _rest;///< The bytes after an argument which threw, parsed by the next call
+        bool _operands_only = false;///< Whether a \c \-\- was seen
+
+        /// Parses the arguments completed by the bytes, keeps the rest on error
+        void consume(std::string_view bytes);
+        /// Parses the bytes kept in \c _rest, along with the input appended to them
+        void resume();
+        /// Parses the completed argument in \c _arg, which is cleared either way
+        void flush();
+    };
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../src/push_parser.cxx"
+#endif
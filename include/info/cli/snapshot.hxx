@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines mapped_snapshot, a read-only view of a cli_parser snapshot stored
+ * in a file.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <info/cli/macros.hxx>
+
+namespace info::cli {
+    /**
+     * \brief A cli_parser snapshot mapped into memory from a file
+     *
+     * Owns the memory mapping of a file containing a snapshot created by
+     * cli_parser::snapshot, so a cli_parser can be loaded from it without
+     * reading the whole file up front. On platforms without \c mmap the
+     * file is read into memory instead.
+     *
+     * The mapped_snapshot must outlive every cli_parser loaded from it.
+     */
+    struct INFO_CLI_API mapped_snapshot {
+        /**
+         * \brief Maps the snapshot file at the given path
+         *
+         * \throws std::system_error if the file cannot be opened or mapped
+         *
+         * \param path The path of the snapshot file
+         */
+        explicit mapped_snapshot(const char* path);
+
+        mapped_snapshot(const mapped_snapshot&) = delete;
+        mapped_snapshot& operator=(const mapped_snapshot&) = delete;
+
+        /// Unmaps the file
+        ~mapped_snapshot();
+
+        /**
+         * \brief Returns the contents of the snapshot file
+         *
+         * \return The view of the mapped snapshot, to be passed to cli_parser
+         */
+        [[nodiscard]] std::string_view
+        view() const noexcept {
+            return {_data, _size};
+        }
+
+    private:
+        const char* _data = nullptr;///< The start of the mapping
+        std::size_t _size = 0;      ///< The size of the mapping
+        std::string _fallback;      ///< The contents of the file if it could not be mapped
+    };
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../src/snapshot.cxx"
+#endif
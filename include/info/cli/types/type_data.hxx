@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <cctype>
 #include <functional>
 #include <string_view>
 #include <type_traits>
@@ -196,6 +197,27 @@ namespace info::cli {
         constexpr const static std::string_view type_name = type_data<T>::type_name;
     };
 
+    /**
+     * \copydoc type_data
+     *
+     * \note
+     * For documentation of the data members see the unspecialized
+     * type_data class template
+     *
+     * The lazy modifier parses like its wrapped type, but as the length of the
+     * value cannot be checked without parsing it, it is taken whole.
+     */
+    template<class T>
+    struct INFO_CLI_LOCAL type_data<cli::lazy<T>> {
+        using wrapped_data = type_data<meta::expected_type<T>>;///< The type_data of the wrapped type
+
+        constexpr const static bool allow_nothing = wrapped_data::allow_nothing;
+        constexpr const static std::string_view default_value = wrapped_data::default_value;
+        constexpr const static int length = -1;
+        constexpr const static parse_type expected_type = wrapped_data::expected_type;
+        constexpr const static std::string_view type_name = wrapped_data::type_name;
+    };
+
     /**
      * \copydoc type_data
      *
@@ -294,6 +316,71 @@ namespace info::cli {
                length{type_data<T>::length},
                expected_type{type_data<T>::expected_type},
                type_name{type_data<T>::type_name} { }
+
+        /**
+         * \brief Constructs the runtime type information object from its attributes
+         *
+         * Restores an already type erased runtime type information object from
+         * its attributes, like when the parser is loaded from a snapshot.
+         *
+         * \param allow_nothing Whether the type allows a valueless option call
+         * \param default_val The value to use in a valueless option call
+         * \param length The maximal length of the value or \c -1
+         * \param expected_type The characters accepted by the type's parser
+         * \param type_name The human readable name of the type
+         */
+        constexpr rt_type_data(bool allow_nothing,
+                               std::string_view default_val,
+                               int length,
+                               parse_type expected_type,
+                               std::string_view type_name) noexcept
+             : allow_nothing{allow_nothing},
+               default_val{default_val},
+               length{length},
+               expected_type{expected_type},
+               type_name{type_name} { }
     };
 
 }
+
+namespace info::_cli::parsing {
+    /**
+     * \brief The non-allocating version of parse_type_accepts for the hot loop
+     *
+     * \param type The parse_type to check
+     * \param ch The character to check
+     *
+     * \return Whether the parse_type accepts the character
+     */
+    inline INFO_CLI_LOCAL bool
+    accepts(info::cli::parse_type type, char ch) noexcept {
+        using info::cli::parse_type;
+        auto uch = static_cast<unsigned char>(ch);
+        switch (type) {
+        case parse_type::alpha: return std::isalpha(uch) != 0;
+        case parse_type::alphanumeric: return std::isalnum(uch) != 0;
+        case parse_type::numeric: return std::isdigit(uch) != 0;
+        case parse_type::printable: return std::isprint(uch) != 0;
+        case parse_type::any: return true;
+        }
+        INFO_CLI_NOT_HAPPENING;
+    }
+
+    /**
+     * \brief Cuts the value of a finite type from the argument, never reading past its end
+     *
+     * \param data The runtime type information of the option's type
+     * \param arg The rest of the argument, starting at the value
+     *
+     * \return The part of the argument that is the value
+     */
+    inline INFO_CLI_LOCAL std::string_view
+    value_of(const info::cli::rt_type_data& data, std::string_view arg) noexcept {
+        return data.length != -1 ? arg.substr(0, static_cast<std::size_t>(data.length))
+                                 : arg;
+    }
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../../src/types/type_data.cxx"
+#endif
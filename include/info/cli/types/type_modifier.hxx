@@ -13,6 +13,8 @@
 
 #include <type_traits>
 
+#include <info/cli/extra/lazy.hxx>
+#include <info/cli/extra/on_duplicate.hxx>
 #include <info/cli/extra/repeat.hxx>
 #include <info/cli/macros.hxx>
 
@@ -38,7 +40,7 @@ namespace info::cli {
      * \tparam T The type to check for modifierness(, even if that's not a word)
      */
     template<class T>
-    struct INFO_CLI_API type_modifier_ : std::false_type {
+    struct type_modifier_ : std::false_type {
         /**
          * \brief Returns an lvalue reference to the callback variable
          *
@@ -68,7 +70,7 @@ namespace info::cli {
      * \tparam T The type embedded in the repeat type modifier
      */
     template<class T>
-    struct INFO_CLI_API type_modifier_<repeat<T>> : std::true_type {
+    struct type_modifier_<repeat<T>> : std::true_type {
         /**
          * \brief Returns an lvalue reference to the user-given callback variable
          *
@@ -95,6 +97,62 @@ namespace info::cli {
         }
     };
 
+    /**
+     * \copybrief type_modifier_
+     *
+     * Implementation for the InfoCLI provided on_duplicate type modifier, which
+     * just unwraps the associative container.
+     *
+     * \tparam Policy The duplicate_key policy of the modifier
+     * \tparam T The type embedded in the type modifier
+     */
+    template<duplicate_key Policy, class T>
+    struct type_modifier_<on_duplicate_<Policy, T>> : std::true_type {
+        /**
+         * \brief Returns an lvalue reference to the user-given callback variable
+         *
+         * \tparam Ft Type for the forwarding reference
+         * \param x The on_duplicate_ instance to extract the lvalue reference from
+         *
+         * \return The lvalue reference extracted from the type modifier
+         */
+        template<class Ft>
+        auto&
+        operator()(Ft&& x) const noexcept {
+            return x.value;
+        }
+    };
+
+    /**
+     * \copybrief type_modifier_
+     *
+     * Implementation for the InfoCLI provided lazy type modifier. Unlike the
+     * other modifiers, lazy is not a wrapper around the user's variable, but
+     * the variable itself, so it must be given as an lvalue, in which case
+     * this specialization is not even used. It only exists to reject
+     * temporaries, which would not outlive the parser.
+     *
+     * \tparam T The type of the lazy value
+     */
+    template<class T>
+    struct type_modifier_<lazy<T>> : std::true_type {
+        /**
+         * \brief Returns the lvalue reference to the lazy value
+         *
+         * \tparam Ft Type for the forwarding reference
+         * \param x The lazy value
+         *
+         * \return The lvalue reference to the lazy value
+         */
+        template<class Ft>
+        auto&
+        operator()(Ft&& x) const noexcept {
+            static_assert(std::is_lvalue_reference_v<Ft>,
+                          "A lazy value holds the result itself, declare it as a variable.");
+            return x;
+        }
+    };
+
     /**
      * \brief Convenience variable for checking if type is a type modifier
      *
@@ -40,12 +40,17 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <info/expected.hpp>
 
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/extra/lazy.hxx>
 #include <info/cli/extra/repeat.hxx>
 #include <info/cli/macros.hxx>
 #include <info/cli/meta/meta.hxx>
+#include <info/cli/types/type_data.hxx>
 
 namespace info::cli {
     /**
@@ -93,7 +98,7 @@ namespace info::cli {
      * \tparam T The type to parse the string into
      */
     template<class T>
-    struct INFO_CLI_API type_parser {
+    struct type_parser {
         /**
          * \brief Performs the parsing from string to a given type
          *
@@ -142,7 +147,7 @@ namespace info::cli {
             T tmp;
             last = str.data() + str.size();
 
-            std::istringstream ss{str.data()};
+            std::istringstream ss{std::string(str)};
             if (ss >> tmp) {
                 return tmp;
             }
@@ -159,7 +164,50 @@ namespace info::cli {
      * type_parser implementing parsing for the contained type.
      */
     template<class T>
-    struct INFO_CLI_API type_parser<cli::repeat<T>> : type_parser<T> { };
+    struct type_parser<cli::repeat<T>> : type_parser<T> { };
+
+    /** \copybrief type_parser
+     * \copydetails type_parser
+     *
+     * This type_parser is specialized for key-value pairs given as `KEY=VALUE`,
+     * as used by associative containers. The argument is split on the first
+     * `=`, the key and the value are then parsed from the views of the two
+     * halves by their own type_parser. The key has to be consumed whole.
+     */
+    template<class K, class V>
+    struct type_parser<std::pair<K, V>> {
+        /**
+         * \brief Parses the `KEY=VALUE` pair
+         *
+         * \param str The string to parse into the pair
+         * \param last A pointer pointing at the first unconvertible character
+         *              of the value
+         *
+         * \return The parsed pair, or the parser_opcode of the first failure
+         */
+        info::expected<std::pair<K, V>, parser_opcode>
+        operator()(std::string_view str, const char*& last) const noexcept {
+            auto eq = str.find('=');
+            if (eq == std::string_view::npos) {
+                return INFO_UNEXPECTED{parser_opcode::terminate};
+            }
+
+            const char* key_last = nullptr;
+            auto key = type_parser<K>{}(str.substr(0, eq), key_last);
+            if (!key) {
+                return INFO_UNEXPECTED{key.error()};
+            }
+            if (key_last != str.data() + eq) {// trailing garbage in the key
+                return INFO_UNEXPECTED{parser_opcode::terminate};
+            }
+
+            auto val = type_parser<V>{}(str.substr(eq + 1), last);
+            if (!val) {
+                return INFO_UNEXPECTED{val.error()};
+            }
+            return std::pair<K, V>{std::move(*key), std::move(*val)};
+        }
+    };
 
     /**
      * Implementation detail. Ignore.
@@ -177,3 +225,37 @@ namespace info::cli {
 }
 
 #undef SPECIALIZED_PARSERS
+
+template<class T>
+T
+info::_cli::parse_lazy(T ret, std::string_view name, const std::vector<std::string_view>& sources) {
+    using parsed_type = aggregator_type<T>;
+
+    for (auto source : sources) {
+        const char* last = nullptr;
+        auto val = cli::type_parser<parsed_type>{}(source, last);
+        if (!val) {
+            if (val.error() == cli::parser_opcode::ignore) {
+                continue;
+            }
+            throw cli::bad_option_value(std::string(name),
+                                        cli::type_data<cli::meta::expected_type<T>>::type_name,
+                                        std::string(source));
+        }
+
+        if constexpr (aggregator<T>) {
+            if (!aggregate<T>(ret, std::move(*val))) {
+                throw cli::bad_option_value(std::string(name),
+                                            cli::type_data<cli::meta::expected_type<T>>::type_name,
+                                            std::string(source));
+            }
+        } else {
+            ret = std::move(*val);
+        }
+    }
+    return ret;
+}
+
+#if INFO_CLI_HEADER_ONLY
+#    include "../../../../src/types/type_parser.cxx"
+#endif
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements the batch_parser, which parses blocks of command lines on
+ * multiple threads, each with its own parser loaded from a snapshot
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include <info/cli/batch_parser.hxx>
+#include <info/cli/buffer_parser.hxx>
+
+namespace info::_cli::batch {
+    /// The amount of lines handed to a thread at once; a multiple of 64, so threads write whole words of bit sets
+    constexpr const std::size_t block = 1024;
+
+    /// The results of a block of lines, merged in order after the parse
+    struct INFO_CLI_LOCAL block_result {
+        std::vector<std::string_view> operands;
+        std::vector<std::size_t> counts;///< The amount of operands of each line
+        std::vector<cli::batch_error> errors;
+    };
+}
+
+INFO_CLI_INLINE
+info::cli::batch_parser::batch_parser(const cli_parser& schema)
+     : _snapshot(schema.snapshot()),
+       _unknown(schema._unk_behavior) {
+    const auto count = schema._callbacks.size() - schema._auto_help;
+    _types.resize(count);
+    _columns.resize(count);
+    for (std::size_t i = 0; i < schema.sorted_name_count(); ++i) {
+        auto name = schema.sorted_name(i);
+        auto [type, id] = *schema.find_option(name);
+        if (id >= count) {// the Auto-Help
+            continue;
+        }
+        _types[id] = {type.expected_type, type.length};
+        _ids.emplace(name, id);
+    }
+}
+
+INFO_CLI_INLINE
+info::cli::batch_parser::~batch_parser() = default;
+
+INFO_CLI_INLINE void
+info::cli::batch_parser::add_column(std::string_view name, std::unique_ptr<_cli::batch_column> column) {
+    auto it = _ids.find(std::string(name));
+    if (it == _ids.end()) {
+        throw std::invalid_argument(fmt::format("column of unknown option '{}'", name));
+    }
+    auto& slot = _columns[it->second];
+    if (slot) {
+        throw std::invalid_argument(fmt::format("option '{}' already has a column", name));
+    }
+    slot = std::move(column);
+}
+
+INFO_CLI_INLINE void
+info::cli::batch_parser::operator()(const std::vector<std::string_view>& lines) {
+    namespace bt = _cli::batch;
+
+    for (auto& col : _columns) {
+        if (col) {
+            col->resize(lines.size());
+        }
+    }
+
+    std::vector<bt::block_result> results((lines.size() + bt::block - 1) / bt::block);
+    std::atomic<std::size_t> next{0};
+    auto work = [this, &lines, &results, &next] {
+        std::vector<std::unique_ptr<_cli::batch_cell>> cells(_columns.size());
+        std::vector<std::size_t> touched;// the cells given in the current line
+        std::vector<std::function<option::callback_type>> callbacks;
+        callbacks.reserve(_columns.size());
+        for (std::size_t id = 0; id < _columns.size(); ++id) {
+            if (!_columns[id]) {// skip what the type_parser would take
+                callbacks.emplace_back([type = _types[id]](std::string_view value, const char*& last) {
+                    std::size_t len = 0;
+                    while (len < value.size() && _cli::parsing::accepts(type.expected_type, value[len])) {
+                        ++len;
+                    }
+                    if (type.length != -1) {
+                        len = std::min(len, static_cast<std::size_t>(type.length));
+                    }
+                    last = value.data() + len;
+                    return true;
+                });
+                continue;
+            }
+            cells[id] = _columns[id]->cell();
+            callbacks.emplace_back([cell = cells[id].get(), id, &touched](std::string_view value, const char*& last) {
+                if (!cell->touched) {
+                    cell->touched = true;
+                    touched.push_back(id);
+                }
+                return cell->parse(value, last);
+            });
+        }
+
+        cli_parser parser(from_snapshot, _snapshot, std::move(callbacks));
+        parser.unknown_behavior(_unknown);
+        parser._auto_help = false;// a batch must not exit, --help is skipped by its callback
+        buffer_parser parse(parser);
+
+        for (auto b = next++; b < results.size(); b = next++) {
+            auto& [operands, counts, errors] = results[b];
+            const auto end = std::min(lines.size(), (b + 1) * bt::block);
+            for (auto line = b * bt::block; line < end; ++line) {
+                try {
+                    const auto& ops = parse(lines[line]);
+                    operands.insert(operands.end(), ops.begin(), ops.end());
+                    counts.push_back(ops.size());
+                    for (auto id : touched) {
+                        cells[id]->store(line);
+                    }
+                } catch (const std::exception& err) {
+                    counts.push_back(0);
+                    for (auto id : touched) {
+                        cells[id]->discard();
+                    }
+                    errors.push_back({line, err.what()});
+                }
+                touched.clear();
+            }
+        }
+    };
+
+    std::size_t threads = _threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<std::size_t>(1, std::min(threads, results.size()));
+
+    // a thread failing to set up its parser must not terminate the program
+    std::vector<std::exception_ptr> failures(threads);
+    auto guarded = [&work, &failures](std::size_t t) {
+        try {
+            work();
+        } catch (...) {
+            failures[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        try {
+            workers.emplace_back(guarded, t);
+        } catch (const std::system_error&) {// make do with what we have
+            break;
+        }
+    }
+    guarded(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& failure : failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    _operands.values.clear();
+    _operands.offsets.clear();
+    _operands.offsets.reserve(lines.size() + 1);
+    _errors.clear();
+    for (auto& [operands, counts, errors] : results) {
+        auto offset = _operands.values.size();
+        for (auto count : counts) {
+            _operands.offsets.push_back(offset);
+            offset += count;
+        }
+        _operands.values.insert(_operands.values.end(), operands.begin(), operands.end());
+        std::move(errors.begin(), errors.end(), std::back_inserter(_errors));
+    }
+    _operands.offsets.push_back(_operands.values.size());
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements parsing the NUL-separated arguments of contiguous buffers
+ */
+
+#include <cstring>
+
+#include <info/cli/buffer_parser.hxx>
+
+INFO_CLI_INLINE std::vector<std::string_view>
+info::cli::cli_parser::operator()(std::string_view args) {
+    buffer_parser parse(*this);
+    return parse(args);
+}
+
+INFO_CLI_INLINE
+info::cli::buffer_parser::buffer_parser(cli_parser& parser) noexcept
+     : _parser(parser) { }
+
+INFO_CLI_INLINE const std::vector<std::string_view>&
+info::cli::buffer_parser::operator()(std::string_view args) {
+    _argv.clear();
+    _operands.clear();
+    _last.clear();
+
+    // the parser never writes the arguments, it only takes them as char*
+    auto* begin = const_cast<char*>(args.data());
+    auto* end = begin + args.size();
+    while (begin != end) {
+        auto* nul = static_cast<char*>(std::memchr(begin, '\0', static_cast<std::size_t>(end - begin)));
+        if (nul == nullptr) {// the last argument is not terminated
+            _last.assign(begin, end);
+            _argv.push_back(_last.data());
+            break;
+        }
+        _argv.push_back(begin);
+        begin = nul + 1;
+    }
+
+    _parser.parse_arguments(_argv.size(), _argv.data(), cli_parser::operand_sink(_operands));
+
+    if (!_last.empty() && !_operands.empty()
+        && _operands.back().data() == _last.data()) {// to view the buffer, as the rest
+        _operands.back() = args.substr(args.size() - _last.size());
+    }
+    return _operands;
+}
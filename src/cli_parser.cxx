@@ -6,112 +6,162 @@
  *  => contains all the parsing logic
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cctype>
 #include <cstdio>
 #include <cstring>
-#include <filesystem>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 #include <fmt/format.h>
 
 #include <info/cli/cli_parser.hxx>
 #include <info/cli/exc/bad_option_value.hxx>
 #include <info/cli/exc/callback_error.hxx>
+#include <info/cli/exc/constraint_error.hxx>
 #include <info/cli/exc/no_such_option.hxx>
+#include <info/cli/exc/validation_error.hxx>
 #include <info/lambda.hpp>
 
-template<class T>
-static std::string
-format_opts(const std::vector<std::pair<std::string_view, T*>>& opts) {
-    std::string ret;
-    for (const auto& [name, info] : opts) {
-        const auto& [data, _] = *info;
+namespace info::_cli::parsing {
+    template<class T>
+    std::string
+    format_opts(const std::pmr::vector<std::pair<std::string_view, T*>>& opts) {
+        std::string ret;
+        for (const auto& [name, info] : opts) {
+            const auto& [data, _] = *info;
+
+            auto dashes = name.size() == 1 ? "-"
+                                           : "--";
+
+            if (data.type_name == "bool") {
+                ret += fmt::format("{}{}, ",
+                                   dashes,
+                                   name);
+                continue;
+            }
 
-        auto dashes = name.size() == 1 ? "-"
-                                       : "--";
+            auto opt_beg = data.allow_nothing ? '['
+                                              : '<';
+            auto opt_end = data.allow_nothing ? ']'
+                                              : '>';
 
-        if (data.type_name == "bool") {
-            ret += fmt::format("{}{}, ",
+            ret += fmt::format("{}{} {}{}{}, ",
                                dashes,
-                               name);
-            continue;
+                               name,
+                               opt_beg,
+                               data.type_name,
+                               opt_end);
         }
-
-        auto opt_beg = data.allow_nothing ? '['
-                                          : '<';
-        auto opt_end = data.allow_nothing ? ']'
-                                          : '>';
-
-        ret += fmt::format("{}{} {}{}{}, ",
-                           dashes,
-                           name,
-                           opt_beg,
-                           data.type_name,
-                           opt_end);
+        return ret.substr(0, ret.size() - 2);
     }
-    return ret.substr(0, ret.size() - 2);
 }
 
-void
-info::cli::cli_parser::short_option(std::vector<std::string_view>& ops,
-                                    char* arg,
+INFO_CLI_INLINE void
+info::cli::cli_parser::short_option(operand_sink& ops,
+                                    std::string_view arg,
                                     size_t argc,
                                     char** argv,
                                     size_t& i) {
-    if (arg[0] != '\0'
-        && arg[1] == '\0') {// short unpacked option 'x' (option stripped)
-        return unpacked_shorts(ops, arg, argc, argv, i);
+    // each packed step consumes at least one character, so the group is
+    // handled in one linear pass without recursing per character
+    while (!arg.empty()) {
+        if (arg.size() == 1) {// short unpacked option 'x' (option stripped)
+            return unpacked_shorts(ops, arg, argc, argv, i);
+        }
+        arg = packed_shorts(ops, arg, argc, argv, i);
     }
-    packed_shorts(ops, arg, argc, argv, i);
 }
 
-std::vector<std::string_view>
+INFO_CLI_INLINE std::vector<std::string_view>
 info::cli::cli_parser::operator()(int argc, char** argv) {
     return (*this)(static_cast<std::size_t>(argc), argv);
 }
 
-std::vector<std::string_view>
+INFO_CLI_INLINE std::vector<std::string_view>
 info::cli::cli_parser::operator()(std::size_t argc, char** argv) {
-    std::filesystem::path argv0(argv[0]);
-    _exec = argv0.filename().string();
-
     std::vector<std::string_view> operands;
-    operands.reserve(static_cast<unsigned>(argc));
+    operands.reserve(argc);
+    parse(argc, argv, operand_sink(operands));
+    return operands;
+}
+
+INFO_CLI_INLINE std::pmr::vector<std::string_view>
+info::cli::cli_parser::operator()(std::size_t argc, char** argv, std::pmr::memory_resource* resource) {
+    std::pmr::vector<std::string_view> operands(resource);
+    operands.reserve(argc);
+    parse(argc, argv, operand_sink(operands));
+    return operands;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::parse(std::size_t argc, char** argv, operand_sink ops) {
+    if (INFO_CLI_UNLIKELY(_completion
+                          && argc > 1
+                          && std::strcmp(argv[1], "__complete") == 0)) {
+        print_completions(argc, argv);
+        std::exit(0);
+    }
+    parse_arguments(argc, argv, ops);
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::parse_arguments(std::size_t argc, char** argv, operand_sink ops) {
+    if (argc > 0) {// the file name of argv[0] without allocating a path
+#ifdef _WIN32
+        constexpr const auto separators = "\\/";
+#else
+        constexpr const auto separators = "/";
+#endif
+        _exec = argv[0];
+        _exec.remove_prefix(_exec.find_last_of(separators) + 1);// npos + 1 == 0
+    }
+
+    if (_presize) {
+        presize_aggregates(argc, argv);
+    }
+    _pending.clear();
+    _next_slot = 0;
+    reset_seen();
 
     for (std::size_t i = 0; i != argc; ++i) {
-        // handle long options "--"
-        bool long_opt = std::memcmp("--", argv[i], sizeof("--") - 1) == 0;
-        if (long_opt) {
-            if (argv[i][2] == '\0') {// "--"
-                for (std::size_t j = i + 1; j != argc; ++j) {
-                    operands.emplace_back(argv[j]);
-                }
-                return operands;
+        if (std::strcmp(argv[i], "--") == 0) {
+            if (INFO_CLI_UNLIKELY(_forwarding)) {// the child gets the boundary too
+                forward_rest(ops, argc, argv, i);
+                break;
             }
-            long_option(operands, argc, argv, i);
-            continue;
-        }
-
-        // handle short options "-"
-        bool short_opt = argv[i][0] == '-';
-        if (short_opt) {
-            if (argv[i][1] == '\0') {// "-"
-                operands.emplace_back("-");
-            } else {
-                short_option(operands, strip_option(argv[i]), argc, argv, i);
+            for (std::size_t j = i + 1; j != argc; ++j) {
+                operand(ops, argv[j]);
             }
+            break;
+        }
+        if (i == 0 && argv[i][0] != '-') {// the program name is not parsed into the slots
+            ops(argv[i]);
             continue;
         }
-
-        // else
-        operands.emplace_back(argv[i]);
+        if (INFO_CLI_UNLIKELY(_forwarding)
+            && _forwarding_mode == forwarding::posix
+            && (argv[i][0] != '-' || argv[i][1] == '\0')) {// the first operand
+            forward_rest(ops, argc, argv, i);
+            break;
+        }
+        argument(ops, argc, argv, i);
     }
 
-    return operands;
+    if (!_pending.empty()) {
+        run_validators();
+    }
+    check_constraints();
 }
 
-namespace {
+namespace info::_cli::parsing {
     template<class C>
     C*
     strip_generic(C* opt, bool lng) {
@@ -126,71 +176,128 @@ namespace {
     }
 }
 
-char*
+INFO_CLI_INLINE char*
 info::cli::cli_parser::strip_option(char* opt, bool lng) {
-    return strip_generic(opt, lng);
+    return _cli::parsing::strip_generic(opt, lng);
 }
 
-const char*
+INFO_CLI_INLINE const char*
 info::cli::cli_parser::strip_option(const char* opt, bool lng) {
-    return strip_generic(opt, lng);
+    return _cli::parsing::strip_generic(opt, lng);
+}
+
+INFO_CLI_INLINE
+info::cli::cli_parser::cli_parser(std::initializer_list<option> opts)
+     : cli_parser(opts, std::pmr::get_default_resource()) { }
+
+INFO_CLI_INLINE
+info::cli::cli_parser::cli_parser(std::initializer_list<option> opts, std::pmr::memory_resource* resource)
+     : _resource(resource) {
+    add_options(opts.size(), [&opts](std::size_t i) -> const option& {
+        return opts.begin()[i];
+    });
+}
+
+INFO_CLI_INLINE
+info::cli::cli_parser::cli_parser(cli_parser&& other) noexcept = default;
+
+INFO_CLI_INLINE
+info::cli::cli_parser::cli_parser(std::vector<option>&& opts)
+     : cli_parser(std::move(opts), std::pmr::get_default_resource()) { }
+
+INFO_CLI_INLINE
+info::cli::cli_parser::cli_parser(std::vector<option>&& opts, std::pmr::memory_resource* resource)
+     : _resource(resource) {
+    add_options(opts.size(), [&opts](std::size_t i) -> option& {
+        return opts[i];
+    });
+}
+
+INFO_CLI_INLINE
+info::cli::cli_parser::cli_parser(option* const* opts, std::size_t count) {
+    add_options(count, [opts](std::size_t i) -> option& {
+        return *opts[i];
+    });
 }
 
-info::cli::cli_parser::cli_parser(std::initializer_list<option> opts) {
-    for (auto& [names, type, help, call] : opts) {
-        _callbacks.emplace_back(call);
+template<class Get>
+void
+info::cli::cli_parser::add_options(std::size_t count, Get get) {
+    constexpr const auto movable = !std::is_const_v<std::remove_reference_t<decltype(get(0))>>;
+
+    std::size_t name_count = 2;// help and h
+    std::size_t pool_size = 0;
+    std::size_t slot_count = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& opt = get(i);
+        slot_count += opt.operand != operand_kind::none;
+        name_count += opt.names.size();
+        pool_size += opt.help.size();
+        for (const auto& name : opt.names) {
+            pool_size += name.size();
+        }
+    }
+    // growing would leave garbage behind in monotonic resources, and
+    // reallocating the pool would invalidate the views into it
+    _callbacks.reserve(count + 1);
+    _reservers.reserve(count);
+    _validators.reserve(count);
+    _strings.reserve(pool_size);
+    _options.reserve(name_count);
+    _prefix_index.reserve(name_count);
+    _operand_slots.reserve(slot_count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& [names, type, help, callback, reserve, validator, operand] = get(i);
+        if constexpr (movable) {
+            _callbacks.emplace_back(std::move(callback));
+            _reservers.emplace_back(std::move(reserve));
+            _validators.emplace_back(std::move(validator));
+        } else {
+            _callbacks.emplace_back(callback);
+            _reservers.emplace_back(reserve);
+            _validators.emplace_back(validator);
+        }
         auto pos = _callbacks.size() - 1;
 
-        std::vector<help_innards> innards;
+        if (operand != operand_kind::none) {// not matched by name
+            _operand_slots.push_back({type,
+                                      pos,
+                                      pooled(names.front()),
+                                      pooled(help),
+                                      operand == operand_kind::rest});
+            continue;
+        }
+
+        std::pmr::vector<help_innards> innards(_resource);
+        innards.reserve(names.size());
         for (const auto& name : names) {
-            const auto [it, _] = _options.emplace(name,
-                                                  option_info{type, pos});
+            auto it = _options.find(name);
+            if (it == _options.end()) {
+                it = _options.emplace(pooled(name), option_info{type, pos}).first;
+            }
             const auto& [str, val] = *it;
-            innards.emplace_back(std::string_view{str.data(), str.size()}, &val);
+            innards.emplace_back(str, &val);
         }
 
         if (!help.empty()) {
-            _helps.emplace(help, std::move(innards));
+            _helps.emplace(pooled(help), std::move(innards));
         }
     }
-    if (!_helps.empty()
+    if (std::none_of(_reservers.begin(), _reservers.end(), [](const auto& fn) { return bool(fn); })) {
+        _reservers.clear();// makes presize a no-op
+    }
+    if (std::none_of(_validators.begin(), _validators.end(), [](const auto& fn) { return bool(fn); })) {
+        _validators.clear();// nothing is queued for validation
+    }
+    auto documented_operands = std::any_of(_operand_slots.begin(), _operand_slots.end(), [](const auto& slot) {
+        return !slot.help.empty();
+    });
+    if ((!_helps.empty() || documented_operands)
         && _options.find("help") == _options.end()) {
-        _callbacks.emplace_back([&, this](std::string_view, const char*&) -> bool {
-            bool has_long = false;
-            std::string aggregated_opts;
-            for (auto& [name, _opt] : _options) {
-                if (name.size() == 1) {
-                    aggregated_opts += name;
-                } else {
-                    has_long = true;
-                }
-            }
-            std::sort(aggregated_opts.begin(), aggregated_opts.end(), [](char a, char b) {
-                if (std::tolower(a) == std::tolower(b)) {
-                    return std::isupper(a) != 0;
-                }
-                return std::tolower(a) < std::tolower(b);
-            });
-            if (!aggregated_opts.empty()) {
-                aggregated_opts = fmt::format(" [-{}] ", aggregated_opts);
-            }
-            if (has_long) {
-                aggregated_opts = fmt::format("{}[LONG_OPTIONS]", aggregated_opts);
-            }
-
-            fmt::print("USAGE: {}{}{}\n\n",
-                       _exec,
-                       aggregated_opts,
-                       _usage_msg);
-
-            fmt::print("Options:\n");
-            for (const auto& [msg, calls] : _helps) {
-                fmt::print("\t{}\n", format_opts(calls));
-
-                fmt::print("\t\t{}\n", msg);
-            }
-
-            std::exit(1);
+        _auto_help = true;
+        _callbacks.emplace_back([](std::string_view, const char*&) {// printed by call, not to capture this
+            return true;
         });
 
         _options.emplace("help",
@@ -200,171 +307,622 @@ info::cli::cli_parser::cli_parser(std::initializer_list<option> opts) {
                          option_info{rt_type_data(type_data<bool>{}),
                                      _callbacks.size() - 1});
     }
+    build_prefix_index();
 }
 
-std::size_t
+INFO_CLI_INLINE std::string_view
+info::cli::cli_parser::pooled(std::string_view str) {
+    assert(_strings.capacity() - _strings.size() >= str.size());
+    auto offset = _strings.size();
+    _strings.insert(_strings.end(), str.begin(), str.end());
+    return {_strings.data() + offset, str.size()};
+}
+
+INFO_CLI_INLINE std::size_t
 info::cli::cli_parser::size() const noexcept {
-    return _options.size();
+    return sorted_name_count();
 }
 
-void
-info::cli::cli_parser::unpacked_shorts(std::vector<std::string_view>& ops,
-                                       char* arg,
+INFO_CLI_INLINE std::string
+info::cli::cli_parser::usage_options() const {
+    if (!_snapshot.empty()) {
+        return std::string(snapshot_help(true));
+    }
+
+    bool has_long = false;
+    std::string aggregated_opts;
+    for (auto& [name, _opt] : _options) {
+        if (name.size() == 1) {
+            aggregated_opts += name;
+        } else {
+            has_long = true;
+        }
+    }
+    std::sort(aggregated_opts.begin(), aggregated_opts.end(), [](unsigned char a, unsigned char b) {
+        if (std::tolower(a) == std::tolower(b)) {
+            return std::isupper(a) != 0;
+        }
+        return std::tolower(a) < std::tolower(b);
+    });
+    if (!aggregated_opts.empty()) {
+        aggregated_opts = fmt::format(" [-{}] ", aggregated_opts);
+    }
+    if (has_long) {
+        aggregated_opts = fmt::format("{}[LONG_OPTIONS]", aggregated_opts);
+    }
+    for (const auto& slot : _operand_slots) {
+        aggregated_opts += slot.rest ? fmt::format(" [{}...]", slot.name)
+                                     : fmt::format(" <{}>", slot.name);
+    }
+    return aggregated_opts;
+}
+
+INFO_CLI_INLINE std::string
+info::cli::cli_parser::options_help() const {
+    if (!_snapshot.empty()) {
+        return std::string(snapshot_help(false));
+    }
+
+    std::string ret = "Options:\n";
+    for (const auto& [msg, calls] : _helps) {
+        ret += fmt::format("\t{}\n", _cli::parsing::format_opts(calls));
+        ret += fmt::format("\t\t{}\n", msg);
+    }
+
+    bool operands_title = false;
+    for (const auto& slot : _operand_slots) {
+        if (slot.help.empty()) {
+            continue;
+        }
+        if (!operands_title) {
+            ret += "Operands:\n";
+            operands_title = true;
+        }
+        ret += slot.rest ? fmt::format("\t[{}...]\n", slot.name)
+                         : fmt::format("\t<{}>\n", slot.name);
+        ret += fmt::format("\t\t{}\n", slot.help);
+    }
+    return ret;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::print_help() const {
+    fmt::print("USAGE: {}{}{}\n\n",
+               _exec,
+               usage_options(),
+               _usage_msg);
+    fmt::print("{}", options_help());
+
+    std::exit(1);
+}
+
+INFO_CLI_INLINE std::optional<info::cli::cli_parser::option_info>
+info::cli::cli_parser::find_option(std::string_view name) const {
+    if (!_folded.empty() && name.size() > 1) {// holds every long option, even after a freeze
+        auto it = _folded.find(name);
+        if (it == _folded.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+    if (!_snapshot.empty()) {
+        return find_snapshot_option(name);
+    }
+
+    auto it = _options.find(name);
+    if (it == _options.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::unpacked_shorts(operand_sink& ops,
+                                       std::string_view arg,
                                        size_t argc,
                                        char** argv,
                                        size_t& i) {
     const char* last = nullptr;
-    std::string_view inopt{arg};
 
-    auto it = _options.find({inopt.data(), inopt.size()});
-    if (it == _options.end()) {
-        invalid_option(ops, fmt::format("-{}", arg), argv[i]);
+    auto opt = find_option(arg);
+    if (!opt) {
+        invalid_option(ops, arg, argv[i]);
         return;
     }
 
-    auto& [data, idx] = it->second;
-    const auto& fn = _callbacks[idx];
-    assert((bool) fn);
+    auto& [data, idx] = *opt;
 
     if (!data.allow_nothing) {
         if (i + 1 == argc) {
-            throw bad_option_value(std::string(arg, 1), data.type_name, "<none given>");
+            if (_pushing) {
+                return await_value(arg, *opt);
+            }
+            throw bad_option_value(std::string(arg), data.type_name, "<none given>");
         }
         ++i;
 
-        auto str = data.length != -1 ? std::string_view(argv[i], static_cast<std::size_t>(data.length))
-                                     : std::string_view(argv[i]);
-
-        if (!fn(str, last)) {// last ignored
-            throw callback_error(std::string(arg, 1), argv[i]);
+        if (!call(idx, arg, _cli::parsing::value_of(data, argv[i]), last)) {// last ignored
+            throw callback_error(std::string(arg), argv[i]);
         }
-    } else if (INFO_CLI_UNLIKELY(!fn(data.default_val, last))) {// last ignored
-        throw callback_error(std::string(arg, 1), data.default_val.data());
+    } else if (INFO_CLI_UNLIKELY(!call(idx, arg, data.default_val, last))) {// last ignored
+        throw callback_error(std::string(arg), data.default_val.data());
     }
 }
 
-void
-info::cli::cli_parser::packed_shorts(std::vector<std::string_view>& ops,
-                                     char* arg,
-                                     size_t argc,
+INFO_CLI_INLINE std::string_view
+info::cli::cli_parser::packed_shorts(operand_sink& ops,
+                                     std::string_view arg,
+                                     size_t,
                                      char** argv,
                                      size_t& i) {
     const char* last = nullptr;
-    std::string_view inopt(arg);
 
-    auto zeroth_opt = std::string(1, inopt[0]);
-    auto it = _options.find(zeroth_opt);
-    if (it == _options.end()) {
-        invalid_option(ops, fmt::format("-{}", zeroth_opt), argv[i]);
-        return;
+    auto name = arg.substr(0, 1);
+    auto rest = arg.substr(1);
+    auto opt = find_option(name);
+    if (!opt) {
+        invalid_option(ops, name, argv[i]);
+        return {};
     }
-    auto& [data, idx] = it->second;
-    auto& fn = _callbacks[idx];
-    assert((bool) fn);
+    auto& [data, idx] = *opt;
 
-    if (auto it_ = _options.find(std::string(1, inopt[1]));
-        (it_ != _options.end()) && data.allow_nothing) {
+    if (data.allow_nothing
+        && find_option(rest.substr(0, 1))) {
         // if the following is an option and we accept nothing we
         // do not consume it and call the callback with the default
 
-        if (INFO_CLI_UNLIKELY(!fn(data.default_val, last))) {// last ignored
-            throw callback_error(std::string(arg, 1), inopt.substr(1).data());
+        if (INFO_CLI_UNLIKELY(!call(idx, name, data.default_val, last))) {// last ignored
+            throw callback_error(std::string(name), std::string(rest));
         }
 
-        short_option(ops, arg + 1, argc, argv, i);
-    } else if (parse_type_accepts(data.expected_type)(inopt[1])) {
+        return rest;
+    }
+    if (_cli::parsing::accepts(data.expected_type, rest[0])) {
         // munch from input
-        if (!fn(inopt.substr(1, static_cast<std::size_t>(data.length)), last)) {
-            throw callback_error(std::string(arg, 1), inopt.substr(1).data());
+        if (!call(idx, name, _cli::parsing::value_of(data, rest), last)) {
+            throw callback_error(std::string(name), std::string(rest));
         }
 
-        if (last == inopt.data() + inopt.size()) {// the end is here
-            return;
+        auto end = rest.data() + rest.size();
+        if (last == nullptr || last < rest.data() || last >= end) {// the end is here, or the parser did not tell
+            return {};
         }
-
-        short_option(ops, const_cast<char*>(last), argc, argv, i);
-    } else if (data.allow_nothing) {
-        if (INFO_CLI_UNLIKELY(!fn(data.default_val, last))) {// last ignored
-            throw callback_error(std::string(arg, 1), data.default_val.data());
+        return rest.substr(static_cast<std::size_t>(last - rest.data()));
+    }
+    if (data.allow_nothing) {
+        if (INFO_CLI_UNLIKELY(!call(idx, name, data.default_val, last))) {// last ignored
+            throw callback_error(std::string(name), data.default_val.data());
         }
+        return {};
+    }
+    throw bad_option_value(std::string(name), data.type_name, "<none given>");
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::presize_aggregates(std::size_t argc, char** argv) {
+    if (_reservers.empty()) {// nothing to reserve, or loaded from a snapshot
+        return;
+    }
+
+    // allocated on the first presized parse only, as the resource may never free
+    auto& counts = _presize_counts;
+    if (counts.size() != _callbacks.size()) {
+        counts.assign(_callbacks.size(), 0);
     } else {
-        throw bad_option_value(std::string(arg, 1), data.type_name, "<none given>");
+        std::fill(counts.begin(), counts.end(), 0);
+    }
+    auto count = [this, &counts](std::string_view name) {
+        auto opt = find_option(name);
+        if (opt) {
+            ++counts[opt->callback];
+        }
+        return opt;
+    };
+
+    // the counts only have to be upper bounds, so this does not replicate
+    // every rule of the parser, only skips the values of options
+    std::size_t operand_count = 0;
+    for (std::size_t i = 0; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.size() < 2 || arg[0] != '-') {// operand or "-"
+            ++operand_count;
+            continue;
+        }
+
+        if (arg[1] == '-') {
+            if (arg.size() == 2) {// "--"
+                operand_count += argc - i - 1;
+                break;
+            }
+            auto name = arg.substr(2);
+            auto eq = name.find('=');
+            auto opt = count(name.substr(0, eq));
+            if (opt && eq == std::string_view::npos && !opt->type_data.allow_nothing) {
+                ++i;
+            }
+            continue;
+        }
+
+        for (std::size_t j = 1; j < arg.size(); ++j) {// packed or not
+            auto opt = count(arg.substr(j, 1));
+            if (!opt) {
+                break;
+            }
+            if (!opt->type_data.allow_nothing) {// the rest, or the next argument is the value
+                i += j + 1 == arg.size();
+                break;
+            }
+        }
+    }
+
+    for (const auto& slot : _operand_slots) {// may take all of them
+        if (slot.rest) {
+            counts[slot.callback] = operand_count;
+        }
+    }
+
+    for (std::size_t idx = 0; idx < _reservers.size(); ++idx) {
+        if (counts[idx] != 0 && _reservers[idx]) {
+            _reservers[idx](counts[idx]);
+        }
     }
 }
 
-void
-info::cli::cli_parser::long_option(std::vector<std::string_view>& ops, size_t argc, char** argv, size_t& i) {
+INFO_CLI_INLINE bool
+info::cli::cli_parser::call(std::size_t idx,
+                            std::string_view name,
+                            std::string_view value,
+                            const char*& last) {
+    const auto& fn = _callbacks[idx];
+    assert((bool) fn);
+    if (INFO_CLI_UNLIKELY(_auto_help) && idx + 1 == _callbacks.size()) {
+        print_help();
+    }
+
+    if (!fn(value, last)) {
+        return false;
+    }
+    _seen[idx / 64] |= std::uint64_t{1} << idx % 64;
+    if (INFO_CLI_UNLIKELY(!_validators.empty()) && _validators[idx]) {
+        if (last != nullptr
+            && last > value.data()
+            && last < value.data() + value.size()) {// only what the parser consumed
+            value = value.substr(0, static_cast<std::size_t>(last - value.data()));
+        }
+        _pending.push_back({idx, name, value});
+    }
+    return true;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::run_validators() {
+    std::vector<std::string> reasons(_pending.size());
+    std::atomic<std::size_t> next{0};
+    // the values are handed out one by one, so no thread idles while
+    // another has a backlog of slow checks
+    auto work = [this, &reasons, &next] {
+        for (auto i = next++; i < _pending.size(); i = next++) {
+            const auto& [idx, _, value] = _pending[i];
+            reasons[i] = _validators[idx](value);
+        }
+    };
+
+    std::size_t threads = _validation_threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, _pending.size());
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        try {
+            workers.emplace_back(work);
+        } catch (const std::system_error&) {// make do with what we have
+            break;
+        }
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<validation_error::failure> failures;
+    for (std::size_t i = 0; i < _pending.size(); ++i) {
+        if (!reasons[i].empty()) {
+            const auto& [_, name, value] = _pending[i];
+            failures.push_back({std::string(name), std::string(value), std::move(reasons[i])});
+        }
+    }
+    _pending.clear();
+    if (!failures.empty()) {
+        throw validation_error(std::move(failures));
+    }
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::reset_seen() {
+    _seen.assign((_callbacks.size() + 63) / 64, 0);
+}
+
+INFO_CLI_INLINE std::pair<std::size_t, std::string>
+info::cli::cli_parser::constraint_target(std::string_view name) const {
+    if (auto opt = find_option(name)) {
+        auto dashes = name.size() == 1 ? "-"
+                                       : "--";
+        return {opt->callback, fmt::format("'{}{}'", dashes, name)};
+    }
+    for (const auto& slot : _operand_slots) {
+        if (slot.name == name) {
+            return {slot.callback, fmt::format("'<{}>'", name)};
+        }
+    }
+    throw std::invalid_argument(fmt::format("constraint on unknown option '{}'", name));
+}
+
+INFO_CLI_INLINE info::cli::cli_parser&
+info::cli::cli_parser::constraints(std::initializer_list<constraint> cons) {
+    const auto words = (_callbacks.size() + 63) / 64;
+    auto add = [this, words](constraint_kind kind,
+                             std::size_t trigger,
+                             const std::vector<std::size_t>& ids,
+                             std::string message) {
+        auto offset = _constraint_masks.size();
+        _constraint_masks.resize(offset + words);
+        for (auto id : ids) {
+            _constraint_masks[offset + id / 64] |= std::uint64_t{1} << id % 64;
+        }
+        _constraints.push_back({kind, offset, trigger, std::move(message)});
+    };
+
+    for (const auto& [kind, names] : cons) {
+        if (kind == constraint_kind::implies && names.size() < 2) {
+            throw std::invalid_argument("implies constraint without dependencies");
+        }
+
+        std::vector<std::size_t> ids;
+        std::string spelled;
+        for (const auto& name : names) {
+            auto [id, spelling] = constraint_target(name);
+            ids.push_back(id);
+            if (kind == constraint_kind::required) {// split, so each missing one is reported by itself
+                add(kind, 0, {id}, fmt::format("option {} is required", spelling));
+            } else if (kind == constraint_kind::implies && ids.size() == 1) {
+                spelled = spelling + " requires ";
+            } else {
+                spelled += spelling + ", ";
+            }
+        }
+        if (!spelled.empty()) {// the last ", "
+            spelled.resize(spelled.size() - 2);
+        }
+
+        switch (kind) {
+        case constraint_kind::required: break;
+        case constraint_kind::exactly_one_of:
+            add(kind, 0, ids, fmt::format("exactly one of {} must be given", spelled));
+            break;
+        case constraint_kind::mutually_exclusive:
+            add(kind, 0, ids, fmt::format("{} cannot be given together", spelled));
+            break;
+        case constraint_kind::implies:
+            add(kind, ids.front(), {ids.begin() + 1, ids.end()}, std::move(spelled));
+            break;
+        }
+    }
+    return *this;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::check_constraints() const {
+    std::vector<std::string> violations;
+    const auto words = _seen.size();
+    for (const auto& [kind, offset, trigger, message] : _constraints) {
+        const auto* mask = _constraint_masks.data() + offset;
+
+        bool all = true;       // every option of the mask is given
+        bool single = true;    // no word has more than one of them
+        std::size_t words_given = 0;
+        for (std::size_t w = 0; w < words; ++w) {
+            auto given = _seen[w] & mask[w];
+            all &= given == mask[w];
+            single &= (given & (given - 1)) == 0;
+            words_given += given != 0;
+        }
+
+        bool ok = true;
+        switch (kind) {
+        case constraint_kind::required: ok = all; break;
+        case constraint_kind::exactly_one_of: ok = words_given == 1 && single; break;
+        case constraint_kind::mutually_exclusive: ok = words_given <= 1 && single; break;
+        case constraint_kind::implies:
+            ok = all || (_seen[trigger / 64] >> trigger % 64 & 1) == 0;
+            break;
+        }
+        if (!ok) {
+            violations.push_back(message);
+        }
+    }
+    if (!violations.empty()) {
+        throw constraint_error(std::move(violations));
+    }
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::long_option(operand_sink& ops, size_t argc, char** argv, size_t& i) {
     std::string_view inopt{strip_option(argv[i], true)};
     const char* last = nullptr;
 
-    if (auto pos = std::find(inopt.begin(), inopt.end(), '=');
-        pos != inopt.end()) {// GNU-style long options
-        auto dist = static_cast<std::size_t>(std::distance(inopt.begin(), pos));
-        auto opt = inopt.substr(0, dist);
-        auto val = inopt.substr(dist + 1);
+    if (auto pos = inopt.find('=');
+        pos != std::string_view::npos) {// GNU-style long options
+        auto opt = inopt.substr(0, pos);
+        auto val = inopt.substr(pos + 1);
 
-        auto it = _options.find(std::string(opt.data(), opt.size()));
-        if (it == _options.end()) {
+        auto found = find_option(opt);
+        if (!found) {
             invalid_option(ops, argv[i], argv[i]);
             return;
         }
-        auto& [_, idx] = it->second;
-        auto& fn = _callbacks[idx];
-        assert((bool) fn);
+        auto& [_, idx] = *found;
 
-        if (!fn(val, last)) {// last ignored
-            throw callback_error(strip_option(const_cast<char*>(opt.data()), true), val.data());
+        if (!call(idx, opt, val, last)) {// last ignored
+            throw callback_error(std::string(opt), val.data());
         }
         return;
     }
 
-    auto it = _options.find(std::string(inopt.data(), inopt.size()));
-    if (it == _options.end()) {
+    auto opt = find_option(inopt);
+    if (!opt) {
         invalid_option(ops, argv[i], argv[i]);
         return;
     }
-    auto& [data, idx] = it->second;
-    auto& fn = _callbacks[idx];
-    assert((bool) fn);
+    auto& [data, idx] = *opt;
 
     if (!data.allow_nothing) {
         if (i + 1 == argc) {
+            if (_pushing) {
+                return await_value(inopt, *opt);
+            }
             throw bad_option_value(strip_option(argv[i], true), data.type_name, "<none given>");
         }
         ++i;
 
-        auto str = data.length != -1 ? std::string_view(argv[i], static_cast<std::size_t>(data.length))
-                                     : std::string_view(argv[i]);
-
-        if (!fn(str, last)) {// last ignored
+        if (!call(idx, inopt, _cli::parsing::value_of(data, argv[i]), last)) {// last ignored
             throw callback_error(argv[i - 1], argv[i]);
         }
-    } else if (INFO_CLI_UNLIKELY(!fn(data.default_val, last))) {// last ignored
+    } else if (INFO_CLI_UNLIKELY(!call(idx, inopt, data.default_val, last))) {// last ignored
         throw callback_error(argv[i], data.default_val.data());
     }
 }
 
-info::cli::cli_parser&
+INFO_CLI_INLINE void
+info::cli::cli_parser::argument(operand_sink& ops, size_t argc, char** argv, size_t& i) {
+    // handle long options "--"
+    bool long_opt = argv[i][0] == '-' && argv[i][1] == '-';
+    if (long_opt) {
+        long_option(ops, argc, argv, i);
+        return;
+    }
+
+    // handle short options "-"
+    bool short_opt = argv[i][0] == '-';
+    if (short_opt) {
+        if (argv[i][1] == '\0') {// "-"
+            operand(ops, argv[i]);
+        } else {
+            short_option(ops, strip_option(argv[i]), argc, argv, i);
+        }
+        return;
+    }
+
+    // else
+    operand(ops, argv[i]);
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::await_value(std::string_view name, const option_info& opt) {
+    _awaiting_name = name;
+    _awaiting = opt;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::operand(operand_sink& ops, char* arg) {
+    if (_next_slot == _operand_slots.size()) {
+        ops(arg);
+        return;
+    }
+
+    const auto& slot = _operand_slots[_next_slot];
+    const char* last = nullptr;
+    if (!call(slot.callback, slot.name, arg, last)) {// last ignored
+        throw callback_error(std::string(slot.name), arg);
+    }
+    _next_slot += !slot.rest;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::start_push() {
+    _pushing = true;
+    _awaiting.reset();
+    _pending.clear();
+    _next_slot = 0;
+    reset_seen();
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::push_argument(operand_sink& ops, char* arg, bool& operands_only) {
+    if (_awaiting) {
+        auto [data, idx] = *std::exchange(_awaiting, std::nullopt);
+        const char* last = nullptr;
+        if (!call(idx, _awaiting_name, _cli::parsing::value_of(data, arg), last)) {// last ignored
+            throw callback_error(std::string(_awaiting_name), arg);
+        }
+    } else if (operands_only) {
+        operand(ops, arg);
+    } else if (std::strcmp(arg, "--") == 0) {
+        operands_only = true;
+    } else {
+        std::size_t i = 0;
+        argument(ops, 1, &arg, i);
+    }
+
+    // the values are views of the argument, which is gone after this
+    if (!_pending.empty()) {
+        run_validators();
+    }
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::finish_push() {
+    auto awaiting = std::exchange(_awaiting, std::nullopt);
+    _pending.clear();
+    _next_slot = 0;
+    if (awaiting) {
+        reset_seen();
+        throw bad_option_value(std::string(_awaiting_name), awaiting->type_data.type_name, "<none given>");
+    }
+
+    try {
+        check_constraints();
+    } catch (...) {// the next input starts afresh either way
+        reset_seen();
+        throw;
+    }
+    reset_seen();
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::stop_push() noexcept {
+    _pushing = false;
+    _awaiting.reset();
+}
+
+INFO_CLI_INLINE info::cli::cli_parser&
 info::cli::cli_parser::operator[](std::string_view usage_msg) {
     _usage_msg = " ";
     _usage_msg += usage_msg;
     return *this;
 }
 
-void
-info::cli::cli_parser::invalid_option(std::vector<std::string_view>& ops,
-                                      const std::string& opt,
+INFO_CLI_INLINE void
+info::cli::cli_parser::invalid_option(operand_sink& ops,
+                                      std::string_view opt,
                                       char* arg) {
+    if (INFO_CLI_UNLIKELY(_forwarding)) {
+        ops(arg);
+        return;
+    }
+
     switch (_unk_behavior) {
     case unknown_behavior::throw_with_leading:
-        throw no_such_option(opt.substr(0, opt.find('=')));
-    case unknown_behavior::classic:
-        if (arg != nullptr && opt.size() == 2 && opt[0] == '-') {
-            throw no_such_option(strip_option(arg, true));
+        if (opt.size() == 1) {// short options are given by name only, not to allocate when passing back
+            throw no_such_option(fmt::format("-{}", opt));
         }
-        throw no_such_option(strip_option(opt.c_str(), true));
+        throw no_such_option(std::string(opt.substr(0, opt.find('='))));
+    case unknown_behavior::classic:
+        throw no_such_option(strip_option(arg, true));
     case unknown_behavior::pass_back:
-        ops.emplace_back(arg);
+        ops(arg);
         return;
     }
     INFO_CLI_NOT_HAPPENING;
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements the shell-completion support of cli_parser: the prefix index,
+ * the hidden __complete query mode, and the static script generators
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include <info/cli/cli_parser.hxx>
+
+namespace info::_cli::completion {
+    INFO_CLI_INLINE INFO_CLI_LOCAL bool
+    starts_with(std::string_view str, std::string_view pfx) noexcept {
+        return str.size() >= pfx.size()
+               && str.compare(0, pfx.size(), pfx) == 0;
+    }
+
+    /// Quotes the string for use inside single quotes of a POSIX-like shell
+    INFO_CLI_INLINE INFO_CLI_LOCAL std::string
+    shell_quoted(std::string_view str) {
+        std::string ret;
+        ret.reserve(str.size());
+        for (auto ch : str) {
+            if (ch == '\'') {
+                ret += R"('\'')";
+            } else {
+                ret += ch;
+            }
+        }
+        return ret;
+    }
+
+    /// Escapes characters with meaning in a zsh _arguments spec
+    INFO_CLI_INLINE INFO_CLI_LOCAL std::string
+    zsh_escaped(std::string_view str) {
+        std::string ret;
+        ret.reserve(str.size());
+        for (auto ch : str) {
+            if (ch == '[' || ch == ']' || ch == ':' || ch == '\\') {
+                ret += '\\';
+            }
+            ret += ch;
+        }
+        return ret;
+    }
+
+    /// Quotes the string for use inside single quotes of fish
+    INFO_CLI_INLINE INFO_CLI_LOCAL std::string
+    fish_quoted(std::string_view str) {
+        std::string ret;
+        ret.reserve(str.size());
+        for (auto ch : str) {
+            if (ch == '\'' || ch == '\\') {
+                ret += '\\';
+            }
+            ret += ch;
+        }
+        return ret;
+    }
+
+    /// Turns the program name into something usable as a shell function name
+    INFO_CLI_INLINE INFO_CLI_LOCAL std::string
+    identifier(std::string_view program) {
+        std::string ret(program);
+        std::replace_if(
+               ret.begin(), ret.end(), [](char ch) {
+                   return std::isalnum(static_cast<unsigned char>(ch)) == 0;
+               },
+               '_');
+        return ret;
+    }
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::build_prefix_index() {
+    _prefix_index.clear();
+    _prefix_index.reserve(_options.size());
+    for (const auto& [name, _] : _options) {
+        _prefix_index.emplace_back(name);
+    }
+    std::sort(_prefix_index.begin(), _prefix_index.end());
+}
+
+INFO_CLI_INLINE std::size_t
+info::cli::cli_parser::sorted_name_count() const noexcept {
+    if (!_snapshot.empty()) {
+        return snapshot_name_count();
+    }
+    return _prefix_index.size();
+}
+
+INFO_CLI_INLINE std::string_view
+info::cli::cli_parser::sorted_name(std::size_t idx) const noexcept {
+    if (!_snapshot.empty()) {
+        return snapshot_name(idx);
+    }
+    return _prefix_index[idx];
+}
+
+INFO_CLI_INLINE std::unordered_map<std::string_view, std::string_view>
+info::cli::cli_parser::help_map() const {
+    std::unordered_map<std::string_view, std::string_view> helps;
+    if (!_snapshot.empty()) {
+        for (std::size_t i = 0; i < snapshot_name_count(); ++i) {
+            if (auto help = snapshot_option_help(i);
+                !help.empty()) {
+                helps.emplace(snapshot_name(i), help);
+            }
+        }
+        return helps;
+    }
+
+    for (const auto& [msg, innards] : _helps) {
+        for (const auto& [name, _] : innards) {
+            helps.emplace(name, msg);
+        }
+    }
+    return helps;
+}
+
+template<class Fn>
+void
+info::cli::cli_parser::for_each_completion(std::string_view partial, Fn&& fn) const {
+    if (partial.empty() || partial[0] != '-') {// operand
+        return;
+    }
+
+    auto count = sorted_name_count();
+    if (_cli::completion::starts_with(partial, "--")) {
+        auto pfx = partial.substr(2);
+        if (pfx.find('=') != std::string_view::npos) {// value of GNU-style option
+            return;
+        }
+
+        // lower_bound over the sorted names
+        std::size_t first = 0;
+        for (std::size_t len = count; len > 0;) {
+            auto half = len / 2;
+            if (sorted_name(first + half) < pfx) {
+                first += half + 1;
+                len -= half + 1;
+            } else {
+                len = half;
+            }
+        }
+        for (auto i = first; i < count && _cli::completion::starts_with(sorted_name(i), pfx); ++i) {
+            if (auto name = sorted_name(i);
+                name.size() > 1) {
+                fn(name, true);
+            }
+        }
+        return;
+    }
+
+    auto pfx = partial.substr(1);
+    if (pfx.empty()) {// lone dash: every option goes
+        for (std::size_t i = 0; i < count; ++i) {
+            if (auto name = sorted_name(i);
+                name.size() == 1) {
+                fn(name, false);
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            if (auto name = sorted_name(i);
+                name.size() > 1) {
+                fn(name, true);
+            }
+        }
+        return;
+    }
+
+    // anything longer is a packed group, which is already complete as is
+    if (pfx.size() == 1 && find_option(pfx)) {
+        fn(pfx, false);
+    }
+}
+
+INFO_CLI_INLINE std::vector<std::string>
+info::cli::cli_parser::complete(std::string_view partial) const {
+    std::vector<std::string> ret;
+    for_each_completion(partial, [&ret](std::string_view name, bool lng) {
+        auto& str = ret.emplace_back(lng ? "--" : "-");
+        str += name;
+    });
+    return ret;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::print_completions(std::size_t argc, char** argv) const {
+    // argv: <exec> __complete [words...] <partial>
+    std::string_view partial = argc > 2 ? argv[argc - 1] : "";
+
+    if (argc > 3) {// if the previous word awaits a value, the shell completes that
+        std::string_view prev = argv[argc - 2];
+        std::string_view name;
+        if (_cli::completion::starts_with(prev, "--")
+            && prev.find('=') == std::string_view::npos) {
+            name = prev.substr(2);
+        } else if (prev.size() == 2 && prev[0] == '-') {
+            name = prev.substr(1);
+        }
+
+        if (!name.empty()) {
+            if (auto opt = find_option(name);
+                opt && !opt->type_data.allow_nothing) {
+                return;
+            }
+        }
+    }
+
+    for_each_completion(partial, [](std::string_view name, bool lng) {
+        std::fwrite("--", 1, lng ? 2 : 1, stdout);
+        std::fwrite(name.data(), 1, name.size(), stdout);
+        std::fputc('\n', stdout);
+    });
+    std::fflush(stdout);
+}
+
+INFO_CLI_INLINE std::string
+info::cli::cli_parser::completion_script(shell sh, std::string_view program) const {
+    auto helps = help_map();
+    auto help_of = [&helps](std::string_view name) {
+        auto it = helps.find(name);
+        return it == helps.end() ? std::string_view{} : it->second;
+    };
+    auto info_of = [this](std::string_view name) {
+        return *find_option(name);
+    };
+    auto spelled = [](std::string_view name) {
+        return fmt::format("{}{}", name.size() == 1 ? "-" : "--", name);
+    };
+    std::vector<std::string_view> names;
+    names.reserve(sorted_name_count());
+    for (std::size_t i = 0; i < sorted_name_count(); ++i) {
+        names.emplace_back(sorted_name(i));
+    }
+
+    std::string ret;
+    switch (sh) {
+    case shell::bash: {
+        auto fn = _cli::completion::identifier(program);
+        std::string words;
+        std::string valued;
+        for (auto name : names) {
+            words += fmt::format("{} ", spelled(name));
+            if (!info_of(name).type_data.allow_nothing) {
+                valued += fmt::format("{}|", spelled(name));
+            }
+        }
+
+        ret += fmt::format("# bash completion for {0}\n"
+                           "_{1}_complete() {{\n"
+                           "    local cur=\"${{COMP_WORDS[COMP_CWORD]}}\"\n",
+                           program,
+                           fn);
+        if (!valued.empty()) {
+            valued.pop_back();
+            ret += fmt::format("    local prev=\"${{COMP_WORDS[COMP_CWORD-1]}}\"\n"
+                               "    case \"$prev\" in\n"
+                               "        {}) return 0 ;;\n"
+                               "    esac\n",
+                               valued);
+        }
+        ret += fmt::format("    if [[ \"$cur\" == -* ]]; then\n"
+                           "        COMPREPLY=( $(compgen -W '{0}' -- \"$cur\") )\n"
+                           "    fi\n"
+                           "}}\n"
+                           "complete -o default -F _{1}_complete {2}\n",
+                           _cli::completion::shell_quoted(words),
+                           fn,
+                           program);
+        return ret;
+    }
+    case shell::zsh:
+        ret += fmt::format("#compdef {}\n"
+                           "_arguments -s -S \\\n",
+                           program);
+        for (auto name : names) {
+            const auto data = info_of(name).type_data;
+            auto value_spec = data.allow_nothing ? std::string{}
+                                                 : fmt::format(":{}:", _cli::completion::zsh_escaped(data.type_name));
+            auto marker = data.allow_nothing ? ""
+                          : name.size() == 1 ? "+"
+                                             : "=";
+            ret += fmt::format("    '{}' \\\n",
+                               _cli::completion::shell_quoted(fmt::format("{}{}[{}]{}",
+                                                        spelled(name),
+                                                        marker,
+                                                        _cli::completion::zsh_escaped(help_of(name)),
+                                                        value_spec)));
+        }
+        ret += "    '*:file:_files'\n";
+        return ret;
+    case shell::fish:
+        ret += fmt::format("# fish completion for {}\n", program);
+        for (auto name : names) {
+            const auto data = info_of(name).type_data;
+            ret += fmt::format("complete -c {} {} {}{}",
+                               program,
+                               name.size() == 1 ? "-s" : "-l",
+                               name,
+                               data.allow_nothing ? "" : " -r");
+            if (auto help = help_of(name);
+                !help.empty()) {
+                ret += fmt::format(" -d '{}'", _cli::completion::fish_quoted(help));
+            }
+            ret += '\n';
+        }
+        return ret;
+    }
+    INFO_CLI_NOT_HAPPENING;
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements the config_source, which applies the options of a configuration
+ * file through the callbacks of a cli_parser, and re-applies the changed ones
+ */
+
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+#ifdef __linux__
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#    define INFO_CLI_HAS_INOTIFY 1
+#else
+#    include <filesystem>
+#    define INFO_CLI_HAS_INOTIFY 0
+#endif
+
+#include <info/cli/config_source.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/exc/callback_error.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+
+namespace info::_cli::config {
+    /// Strips the whitespace around the string; the result is never null, even if empty
+    INFO_CLI_INLINE INFO_CLI_LOCAL std::string_view
+    trimmed(std::string_view str) noexcept {
+        constexpr const std::string_view space = " \t\r";
+        auto begin = str.find_first_not_of(space);
+        if (begin == std::string_view::npos) {
+            return str.substr(str.size());
+        }
+        auto end = str.find_last_not_of(space);
+        return str.substr(begin, end - begin + 1);
+    }
+
+    /// Whether the applied value is the same as the one in the file, including being given at all
+    INFO_CLI_INLINE INFO_CLI_LOCAL bool
+    same(std::string_view applied, std::string_view value) noexcept {
+        return (applied.data() == nullptr) == (value.data() == nullptr)
+               && applied == value;
+    }
+
+    INFO_CLI_INLINE INFO_CLI_LOCAL std::vector<char>
+    read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), path);
+        }
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    /// Returns the options of the file by name, viewing its contents
+    INFO_CLI_INLINE INFO_CLI_LOCAL std::unordered_map<std::string_view, std::string_view>
+    parse_file(const std::vector<char>& contents) {
+        std::unordered_map<std::string_view, std::string_view> options;
+        std::string_view text(contents.data(), contents.size());
+        while (!text.empty()) {
+            auto eol = text.find('\n');
+            auto line = trimmed(text.substr(0, eol));
+            text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            auto eq = line.find('=');
+            std::string_view value;// null, if not given
+            if (eq != std::string_view::npos) {
+                value = trimmed(line.substr(eq + 1));
+            }
+            options[trimmed(line.substr(0, eq))] = value;
+        }
+        return options;
+    }
+
+#if !INFO_CLI_HAS_INOTIFY
+    INFO_CLI_INLINE INFO_CLI_LOCAL std::int64_t
+    modified(const std::string& path) {
+        std::error_code err;
+        auto time = std::filesystem::last_write_time(path, err);
+        if (err) {
+            throw std::system_error(err, path);
+        }
+        return static_cast<std::int64_t>(time.time_since_epoch().count());
+    }
+#endif
+}
+
+INFO_CLI_INLINE
+info::cli::config_source::config_source(cli_parser& parser, std::string path)
+     : _parser(parser),
+       _path(std::move(path)) {
+#if INFO_CLI_HAS_INOTIFY
+    // the directory is watched, as editors often replace the file instead of writing it
+    auto slash = _path.find_last_of('/');
+    auto dir = slash == std::string::npos ? std::string(".")
+               : slash == 0               ? std::string("/")
+                                          : _path.substr(0, slash);
+    _watch = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_watch == -1 || ::inotify_add_watch(_watch, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        auto err = errno;
+        if (_watch != -1) {
+            ::close(_watch);
+        }
+        throw std::system_error(err, std::generic_category(), dir);
+    }
+
+    try {
+        reload();
+    } catch (...) {
+        ::close(_watch);
+        throw;
+    }
+#else
+    reload();
+#endif
+}
+
+INFO_CLI_INLINE
+info::cli::config_source::~config_source() {
+#if INFO_CLI_HAS_INOTIFY
+    if (_watch != -1) {
+        ::close(_watch);
+    }
+#endif
+}
+
+INFO_CLI_INLINE std::size_t
+info::cli::config_source::poll() {
+#if INFO_CLI_HAS_INOTIFY
+    auto slash = _path.find_last_of('/');
+    std::string_view file = slash == std::string::npos ? std::string_view(_path)
+                                                       : std::string_view(_path).substr(slash + 1);
+
+    bool changed = false;
+    alignas(inotify_event) char buf[4096];
+    for (auto len = ::read(_watch, buf, sizeof buf); len > 0; len = ::read(_watch, buf, sizeof buf)) {
+        for (auto* ptr = buf; ptr < buf + len;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+            changed |= event->len != 0 && file == event->name;
+            ptr += sizeof(inotify_event) + event->len;
+        }
+    }
+    if (!changed) {
+        return 0;
+    }
+#else
+    if (_cli::config::modified(_path) == _modified) {
+        return 0;
+    }
+#endif
+    return reload();
+}
+
+INFO_CLI_INLINE std::size_t
+info::cli::config_source::reload() {
+#if !INFO_CLI_HAS_INOTIFY
+    _modified = _cli::config::modified(_path);
+#endif
+    auto contents = _cli::config::read_file(_path);
+    auto options = _cli::config::parse_file(contents);
+
+    _parser._pending.clear();
+    _parser.reset_seen();
+    std::size_t applied = 0;
+    for (const auto& [name, value] : options) {
+        if (auto it = _applied.find(name);
+            it != _applied.end() && _cli::config::same(it->second, value)) {
+            continue;
+        }
+        apply(name, value);
+        ++applied;
+    }
+    if (!_parser._pending.empty()) {
+        _parser.run_validators();
+    }
+
+    // moving the vector keeps its buffer, which the options view
+    _contents = std::move(contents);
+    _applied = std::move(options);
+    return applied;
+}
+
+INFO_CLI_INLINE int
+info::cli::config_source::native_handle() const noexcept {
+    return _watch;
+}
+
+INFO_CLI_INLINE void
+info::cli::config_source::apply(std::string_view name, std::string_view value) {
+    const char* last = nullptr;
+
+    auto opt = _parser.find_option(name);
+    if (!opt) {
+        throw no_such_option(std::string(name));
+    }
+    auto& [data, idx] = *opt;
+
+    if (value.data() == nullptr) {
+        if (!data.allow_nothing) {
+            throw bad_option_value(std::string(name), data.type_name, "<none given>");
+        }
+        value = data.default_val;
+    }
+    if (!_parser.call(idx, name, _cli::parsing::value_of(data, value), last)) {// last ignored
+        throw callback_error(std::string(name), std::string(value));
+    }
+}
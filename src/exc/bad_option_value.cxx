@@ -8,20 +8,20 @@
 
 #include <fmt/format.h>
 
-const char*
+INFO_CLI_INLINE const char*
 info::cli::bad_option_value::what() const noexcept {
-    static std::string str;
-    str = fmt::format("error: unintelligible value provided for option '{}' (expecting type {}): {}",
-                      opt_name,
-                      type,
-                      args);
-    return str.c_str();
+    return _message.c_str();
 }
 
+INFO_CLI_INLINE
 info::cli::bad_option_value::bad_option_value(std::string opt_name,
                                               std::string_view type,
                                               std::string args)
      : opt_name(std::move(opt_name)),
        type(type),
-       args(std::move(args)) {
+       args(std::move(args)),
+       _message(fmt::format("error: unintelligible value provided for option '{}' (expecting type {}): {}",
+                            this->opt_name,
+                            this->type,
+                            this->args)) {
 }
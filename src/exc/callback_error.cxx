@@ -9,16 +9,16 @@
 
 #include <fmt/format.h>
 
-const char*
+INFO_CLI_INLINE const char*
 info::cli::callback_error::what() const noexcept {
-    static std::string ret;
-    ret = fmt::format("error: error encountered when processing option '{}' with value '{}'",
-                      opt_name,
-                      args);
-    return ret.c_str();
+    return _message.c_str();
 }
 
+INFO_CLI_INLINE
 info::cli::callback_error::callback_error(std::string opt_name, std::string args)
      : opt_name(std::move(opt_name)),
-       args(std::move(args)) {
+       args(std::move(args)),
+       _message(fmt::format("error: error encountered when processing option '{}' with value '{}'",
+                            this->opt_name,
+                            this->args)) {
 }
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements the constraint_error exception
+ */
+
+#include <info/cli/exc/constraint_error.hxx>
+
+#include <fmt/format.h>
+
+INFO_CLI_INLINE const char*
+info::cli::constraint_error::what() const noexcept {
+    return _message.c_str();
+}
+
+INFO_CLI_INLINE
+info::cli::constraint_error::constraint_error(std::vector<std::string> violations)
+     : violations(std::move(violations)),
+       _message(fmt::format("error: {} constraint(s) violated:", this->violations.size())) {
+    for (const auto& violation : this->violations) {
+        _message += fmt::format("\n\t{}", violation);
+    }
+}
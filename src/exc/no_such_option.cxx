@@ -9,13 +9,14 @@
 
 #include <fmt/format.h>
 
-const char*
+INFO_CLI_INLINE const char*
 info::cli::no_such_option::what() const noexcept {
-    static std::string ret;
-    ret = fmt::format("error: unknown option encountered while parsing command line: '{}'", opt_name);
-    return ret.c_str();
+    return _message.c_str();
 }
 
+INFO_CLI_INLINE
 info::cli::no_such_option::no_such_option(std::string opt_name)
-     : opt_name(std::move(opt_name)) {
+     : opt_name(std::move(opt_name)),
+       _message(fmt::format("error: unknown option encountered while parsing command line: '{}'",
+                            this->opt_name)) {
 }
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements the validation_error exception
+ */
+
+#include <info/cli/exc/validation_error.hxx>
+
+#include <fmt/format.h>
+
+INFO_CLI_INLINE const char*
+info::cli::validation_error::what() const noexcept {
+    return _message.c_str();
+}
+
+INFO_CLI_INLINE
+info::cli::validation_error::validation_error(std::vector<failure> failures)
+     : failures(std::move(failures)),
+       _message(fmt::format("error: {} value(s) failed validation:", this->failures.size())) {
+    for (const auto& [opt_name, value, reason] : this->failures) {
+        _message += fmt::format("\n\toption '{}' with value '{}': {}",
+                                opt_name,
+                                value,
+                                reason);
+    }
+}
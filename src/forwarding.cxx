@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements forwarding the arguments a cli_parser does not know, compacted
+ * in place in argv, for wrappers executing a child process
+ */
+
+#include <info/cli/cli_parser.hxx>
+
+INFO_CLI_INLINE char* const*
+info::cli::cli_parser::forward(int& argc, char** argv, forwarding mode) {
+    // the forwarded arguments come in order, and never after the one being
+    // parsed, so they are moved down in place without overwriting any unread
+    std::size_t forwarded = 0;
+    auto compact = [argv, &forwarded](std::string_view arg) {
+        argv[forwarded++] = const_cast<char*>(arg.data());
+    };
+
+    _forwarding = true;
+    _forwarding_mode = mode;
+    try {
+        parse(static_cast<std::size_t>(argc), argv, operand_sink(compact));
+    } catch (...) {
+        _forwarding = false;
+        throw;
+    }
+    _forwarding = false;
+
+    argv[forwarded] = nullptr;
+    argc = static_cast<int>(forwarded);
+    return argv;
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::forward_rest(operand_sink& ops, std::size_t argc, char** argv, std::size_t i) {
+    for (; i != argc; ++i) {
+        ops(argv[i]);
+    }
+}
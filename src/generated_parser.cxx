@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements the Auto-Help of the parsers emitted by infocli-gen
+ */
+
+#include <cstdlib>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <info/cli/generated_parser.hxx>
+
+INFO_CLI_INLINE void
+info::_cli::print_generated_help(const generated_help& help, std::string_view exec) {
+    std::string ret = "Options:\n";
+    for (std::size_t i = 0; i < help.entry_count; ++i) {
+        const auto& entry = help.entries[i];
+        const auto& data = help.types[entry.id];
+
+        std::string names;
+        for (std::size_t j = 0; j < entry.name_count; ++j) {
+            auto name = entry.names[j];
+            auto dashes = name.size() == 1 ? "-"
+                                           : "--";
+            if (data.type_name == "bool") {
+                names += fmt::format("{}{}, ", dashes, name);
+                continue;
+            }
+
+            auto opt_beg = data.allow_nothing ? '['
+                                              : '<';
+            auto opt_end = data.allow_nothing ? ']'
+                                              : '>';
+            names += fmt::format("{}{} {}{}{}, ",
+                                 dashes,
+                                 name,
+                                 opt_beg,
+                                 data.type_name,
+                                 opt_end);
+        }
+        ret += fmt::format("\t{}\n", names.substr(0, names.size() - 2));
+        ret += fmt::format("\t\t{}\n", entry.help);
+    }
+
+    fmt::print("USAGE: {}{}\n\n", exec, help.usage_options);
+    fmt::print("{}", ret);
+
+    std::exit(1);
+}
@@ -7,12 +7,27 @@
 
 #include <info/cli/option.hxx>
 
-info::_cli::helpful_option_builder::helpful_option_builder(const info::_cli::option_builder& bld)
+#include <utility>
+
+INFO_CLI_INLINE info::_cli::helpful_option_builder::helpful_option_builder(const info::_cli::option_builder& bld)
      : helpful_option_builder("", bld) {
 }
 
+INFO_CLI_INLINE
+info::_cli::helpful_option_builder::helpful_option_builder(info::_cli::option_builder&& bld)
+     : helpful_option_builder("", std::move(bld)) {
+}
+
+INFO_CLI_INLINE
 info::_cli::helpful_option_builder::helpful_option_builder(std::string_view help,
                                                            const info::_cli::option_builder& bld)
      : help(help),
        names(bld.names.begin(), bld.names.end()) {
 }
+
+INFO_CLI_INLINE
+info::_cli::helpful_option_builder::helpful_option_builder(std::string_view help,
+                                                           info::_cli::option_builder&& bld)
+     : help(help),
+       names(std::move(bld.names)) {
+}
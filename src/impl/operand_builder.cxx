@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements the builder of operand slots, and the functions starting it
+ */
+
+#include <info/cli/option.hxx>
+
+#include <utility>
+
+INFO_CLI_INLINE
+info::_cli::operand_builder::operand_builder(std::string_view name, cli::operand_kind kind)
+     : name(name),
+       kind(kind) {
+}
+
+INFO_CLI_INLINE info::_cli::operand_builder
+info::_cli::operand_builder::operator>=(std::string_view help) && {
+    this->help = help;
+    return std::move(*this);
+}
+
+INFO_CLI_INLINE info::_cli::operand_builder
+info::cli::operand(std::string_view name) {
+    return {name, operand_kind::single};
+}
+
+INFO_CLI_INLINE info::_cli::operand_builder
+info::cli::operands(std::string_view name) {
+    return {name, operand_kind::rest};
+}
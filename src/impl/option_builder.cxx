@@ -11,30 +11,36 @@
 #include <iterator>
 #include <utility>
 
-info::_cli::option_builder::option_builder(std::string_view name)
-     : names{name.data()} {
+INFO_CLI_INLINE
+info::_cli::option_builder::option_builder(std::string_view name) {
+    names.emplace_back(name);
 }
 
-info::_cli::helpful_option_builder
-info::_cli::option_builder::operator>=(std::string_view help) {
+INFO_CLI_INLINE info::_cli::helpful_option_builder
+info::_cli::option_builder::operator>=(std::string_view help) const& {
     return {help, *this};
 }
 
-info::_cli::option_builder /* clang-format off */
+INFO_CLI_INLINE info::_cli::helpful_option_builder
+info::_cli::option_builder::operator>=(std::string_view help) && {
+    return {help, std::move(*this)};
+}
+
+INFO_CLI_INLINE info::_cli::option_builder /* clang-format off */
 info::_cli::operator/(info::_cli::option_builder bld, std::string_view name) {
                            /* clang-format on */
-    bld.names.emplace_back(name.data());
+    bld.names.emplace_back(name);
     return bld;
 }
 
-info::_cli::option_builder /* clang-format off */
+INFO_CLI_INLINE info::_cli::option_builder /* clang-format off */
 info::_cli::operator/(std::string_view name, info::_cli::option_builder bld) {
                            /* clang-format on */
-    bld.names.emplace_front(name.data());
+    bld.names.emplace(bld.names.begin(), name);
     return bld;
 }
 
-info::_cli::option_builder /* clang-format off */
+INFO_CLI_INLINE info::_cli::option_builder /* clang-format off */
 info::_cli::operator/(info::_cli::option_builder bld1,
                       const info::_cli::option_builder& bld2) {
                            /* clang-format on */
@@ -42,12 +48,22 @@ info::_cli::operator/(info::_cli::option_builder bld1,
     return bld1;
 }
 
-info::_cli::option_builder
+INFO_CLI_INLINE info::_cli::option_builder /* clang-format off */
+info::_cli::operator/(info::_cli::option_builder bld1,
+                      info::_cli::option_builder&& bld2) {
+                           /* clang-format on */
+    std::move(bld2.names.begin(), bld2.names.end(), std::back_inserter(bld1.names));
+    return bld1;
+}
+
+INFO_CLI_INLINE info::_cli::option_builder
 info::_cli::operator/(char name, info::_cli::option_builder bld) {
-    return std::string(1, name) / std::move(bld);
+    bld.names.emplace(bld.names.begin(), 1, name);
+    return bld;
 }
 
-info::_cli::option_builder
+INFO_CLI_INLINE info::_cli::option_builder
 info::_cli::operator/(info::_cli::option_builder bld, char name) {
-    return std::move(bld) / std::string(1, name);
+    bld.names.emplace_back(1, name);
+    return bld;
 }
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Defines the binary layout of cli_parser snapshots. Private to the library.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace info::_cli::snapshot {
+    /// The bytes every snapshot begins with
+    constexpr const char magic[8] = {'I', 'N', 'F', 'O', 'C', 'L', 'I', '\0'};
+    /// The version of the layout; incremented on every incompatible change
+    constexpr const std::uint32_t version = 2;
+    /// Written as-is, so a blob from a different byte order is not loaded
+    constexpr const std::uint32_t byte_order = 0x01020304;
+
+    /// Bit flags of the header
+    enum flags : std::uint32_t {
+        has_auto_help = 1u << 0u,///< The last callback is the Auto-Help
+    };
+
+    /// A string in the string table
+    struct string_ref {
+        std::uint32_t offset;///< Offset from the start of the blob
+        std::uint32_t size;  ///< Length of the string
+    };
+
+    /// The header at the start of the blob
+    struct header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t flags;
+        std::uint32_t callback_count;///< The amount of user callbacks to relink
+        std::uint32_t name_count;
+        std::uint32_t type_count;
+        std::uint32_t slot_count;  ///< The size of the hash index, a power of two larger than name_count
+        std::uint32_t slots_offset;///< Offset of the hash_slot array
+        std::uint32_t names_offset;///< Offset of the name_record array
+        std::uint32_t types_offset;///< Offset of the type_record array
+        std::uint32_t helps_offset;///< Offset of the string_ref array of the help of each name
+        std::uint32_t blob_size;
+        string_ref usage_options;
+        string_ref options_help;
+    };
+
+    /// The most type_records a snapshot can have, as names refer to them by a byte
+    constexpr const std::size_t max_types = 256;
+
+    /// One entry of the name table, which is sorted by name; the help is kept apart, as it is cold
+    struct name_record {
+        string_ref name;
+        std::uint32_t callback;///< The index of the callback
+        std::uint8_t type;     ///< The index of the type_record
+        std::uint8_t padding[3];
+    };
+
+    /// One entry of the open addressing hash index of the names
+    struct hash_slot {
+        std::uint32_t hash;///< The hash of the name, compared before the name itself
+        std::uint32_t name;///< The index of the name_record plus one, or 0 if the slot is empty
+    };
+
+    /// A deduplicated runtime type descriptor
+    struct type_record {
+        string_ref default_val;
+        string_ref type_name;
+        std::int32_t length;
+        std::uint8_t allow_nothing;
+        std::uint8_t expected_type;
+        std::uint8_t padding[2];
+    };
+
+    /// Reads a T from the blob; the blob's data is not necessarily aligned
+    template<class T>
+    T
+    read(std::string_view blob, std::size_t offset) noexcept {
+        T ret;
+        std::memcpy(&ret, blob.data() + offset, sizeof(T));
+        return ret;
+    }
+
+    /// FNV-1a, the hash of the names in the hash index
+    constexpr std::uint32_t
+    hash(std::string_view name) noexcept {
+        std::uint32_t h = 2166136261u;
+        for (char c : name) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    /// Returns the string referenced by the string_ref from the blob
+    inline std::string_view
+    string(std::string_view blob, string_ref ref) noexcept {
+        return blob.substr(ref.offset, ref.size);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements matching long options regardless of their case, dashes, and
+ * underscores: the folding hash and equality, and the index of the folded names
+ */
+
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include <info/cli/cli_parser.hxx>
+
+namespace info::_cli::folding {
+    /// Whether the character is skipped by folding
+    INFO_CLI_INLINE INFO_CLI_LOCAL constexpr bool
+    separator(char ch) noexcept {
+        return ch == '-' || ch == '_';
+    }
+
+    /// The ASCII lowercase of the character; other characters are left as-is
+    INFO_CLI_INLINE INFO_CLI_LOCAL constexpr char
+    lower(char ch) noexcept {
+        return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch - 'A' + 'a')
+                                      : ch;
+    }
+}
+
+INFO_CLI_INLINE std::size_t
+info::_cli::folded_hash::operator()(std::string_view name) const noexcept {
+    std::uint64_t hash = 14695981039346656037ull;// FNV-1a
+    for (auto ch : name) {
+        if (folding::separator(ch)) {
+            continue;
+        }
+        hash ^= static_cast<unsigned char>(folding::lower(ch));
+        hash *= 1099511628211ull;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+INFO_CLI_INLINE bool
+info::_cli::folded_equal::operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    for (;;) {
+        while (i < lhs.size() && folding::separator(lhs[i])) {
+            ++i;
+        }
+        while (j < rhs.size() && folding::separator(rhs[j])) {
+            ++j;
+        }
+        if (i == lhs.size() || j == rhs.size()) {
+            return i == lhs.size() && j == rhs.size();
+        }
+        if (folding::lower(lhs[i++]) != folding::lower(rhs[j++])) {
+            return false;
+        }
+    }
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::name_matching(enum name_matching matching) {
+    folded_options_type folded(_resource);
+    if (matching == cli::name_matching::folded) {
+        const auto count = sorted_name_count();
+        folded.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto name = sorted_name(i);
+            if (name.size() < 2) {// short options are matched exactly
+                continue;
+            }
+
+            auto opt = *find_option(name);
+            auto [it, inserted] = folded.emplace(name, opt);
+            if (!inserted && it->second.callback != opt.callback) {
+                throw std::invalid_argument(fmt::format("options '--{}' and '--{}' are the same when folded",
+                                                        it->first,
+                                                        name));
+            }
+        }
+    }
+    _folded.swap(folded);
+}
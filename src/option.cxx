@@ -8,19 +8,22 @@
 #include <info/cli/option.hxx>
 #include <utility>
 
-info::_cli::option_builder info::cli::udl::operator""_opt(const char* str, std::size_t size) {
+INFO_CLI_INLINE info::_cli::option_builder info::cli::udl::operator""_opt(const char* str, std::size_t size) {
     return {{str, size}};
 }
 
-info::_cli::option_builder info::cli::udl::operator""_opt(char ch) {
-    return {std::string_view{std::string(1, ch)}};
+INFO_CLI_INLINE info::_cli::option_builder info::cli::udl::operator""_opt(char ch) {
+    return {std::string_view(&ch, 1)};
 }
 
+INFO_CLI_INLINE
 info::cli::option::option(std::string help,
                           std::function<bool(std::string_view, const char*&)> callback,
                           std::vector<std::string>&& names,
-                          rt_type_data type)
+                          rt_type_data type,
+                          std::function<void(std::size_t)> reserve)
      : names(std::move(names)),
        type(type),
        help(std::move(help)),
-       callback(std::move(callback)) { }
+       callback(std::move(callback)),
+       reserve(std::move(reserve)) { }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements the push_parser, which feeds the arguments into the incremental
+ * parsing logic of cli_parser
+ */
+
+#include <utility>
+
+#include <info/cli/push_parser.hxx>
+
+INFO_CLI_INLINE
+info::cli::push_parser::push_parser(cli_parser& parser, sink_type sink)
+     : _parser(parser),
+       _sink(std::move(sink)) {
+    _parser.start_push();
+}
+
+INFO_CLI_INLINE
+info::cli::push_parser::~push_parser() {
+    _parser.stop_push();
+}
+
+INFO_CLI_INLINE void
+info::cli::push_parser::push(std::string_view arg) {
+    if (!_rest.empty()) {// the arguments left by an error go first
+        _rest.append(arg.data(), arg.size());
+        _rest.push_back('\0');
+        resume();
+        return;
+    }
+    _arg.append(arg.data(), arg.size());
+    flush();
+}
+
+INFO_CLI_INLINE void
+info::cli::push_parser::feed(std::string_view bytes) {
+    if (!_rest.empty()) {
+        _rest.append(bytes.data(), bytes.size());
+        resume();
+        return;
+    }
+    consume(bytes);
+}
+
+INFO_CLI_INLINE void
+info::cli::push_parser::finish() {
+    if (!_rest.empty()) {
+        resume();
+    }
+    if (!_arg.empty()) {
+        flush();
+    }
+    _operands_only = false;
+    _parser.finish_push();
+}
+
+INFO_CLI_INLINE bool
+info::cli::push_parser::awaiting_value() const noexcept {
+    return _parser._awaiting.has_value();
+}
+
+INFO_CLI_INLINE void
+info::cli::push_parser::consume(std::string_view bytes) {
+    for (auto nul = bytes.find('\0');
+         nul != std::string_view::npos;
+         nul = bytes.find('\0')) {
+        _arg.append(bytes.data(), nul);
+        bytes.remove_prefix(nul + 1);
+        try {
+            flush();
+        } catch (...) {// the rest of the chunk is parsed by the next call
+            _rest.assign(bytes.data(), bytes.size());
+            throw;
+        }
+    }
+    _arg.append(bytes.data(), bytes.size());
+}
+
+INFO_CLI_INLINE void
+info::cli::push_parser::resume() {
+    std::string rest;
+    rest.swap(_rest);
+    consume(rest);
+}
+
+INFO_CLI_INLINE void
+info::cli::push_parser::flush() {
+    cli_parser::operand_sink ops(_sink);
+    try {
+        _parser.push_argument(ops, _arg.data(), _operands_only);
+    } catch (...) {// the failed argument is not completed by the next one
+        _arg.clear();
+        throw;
+    }
+    _arg.clear();
+}
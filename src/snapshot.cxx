@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Implements saving and loading cli_parser snapshots, and mapped_snapshot
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#    define INFO_CLI_HAS_MMAP 1
+#else
+#    include <fstream>
+#    include <iterator>
+#    define INFO_CLI_HAS_MMAP 0
+#endif
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/snapshot.hxx>
+
+#include "impl/snapshot_format.hxx"
+
+namespace info::_cli::snapshot {
+    template<class T>
+    void
+    append(std::string& blob, const T& val) {
+        blob.append(reinterpret_cast<const char*>(&val), sizeof(T));
+    }
+
+    /// Collects the strings of the snapshot; offsets are relative to the table
+    struct INFO_CLI_LOCAL string_table {
+        std::string data;
+
+        string_ref
+        add(std::string_view str) {
+            string_ref ret{static_cast<std::uint32_t>(data.size()),
+                               static_cast<std::uint32_t>(str.size())};
+            data += str;
+            return ret;
+        }
+    };
+
+    INFO_CLI_INLINE INFO_CLI_LOCAL void
+    relocate(string_ref& ref, std::size_t base) noexcept {
+        ref.offset += static_cast<std::uint32_t>(base);
+    }
+
+    INFO_CLI_INLINE INFO_CLI_LOCAL header
+    header_of(std::string_view blob) noexcept {
+        return read<header>(blob, 0);
+    }
+
+    INFO_CLI_INLINE INFO_CLI_LOCAL void
+    check_string(std::string_view blob, string_ref ref) {
+        if (std::uint64_t{ref.offset} + ref.size > blob.size()) {
+            throw std::invalid_argument("cli_parser snapshot has a string out of its bounds");
+        }
+    }
+
+    /**
+     * Checks every record of the blob, whose header and tables were checked
+     * to be in bounds, so lookups in it never read out of bounds, index the
+     * callbacks out of range, or probe forever.
+     */
+    INFO_CLI_INLINE INFO_CLI_LOCAL void
+    validate(std::string_view blob, const header& hdr, std::size_t callbacks) {
+        check_string(blob, hdr.usage_options);
+        check_string(blob, hdr.options_help);
+
+        std::size_t empty_slots = 0;
+        for (std::size_t i = 0; i < hdr.slot_count; ++i) {
+            auto slot = read<hash_slot>(blob, hdr.slots_offset + i * sizeof(hash_slot));
+            if (slot.name > hdr.name_count) {
+                throw std::invalid_argument("cli_parser snapshot has a hash slot out of the names");
+            }
+            empty_slots += slot.name == 0;
+        }
+        if (empty_slots == 0) {
+            throw std::invalid_argument("cli_parser snapshot has a malformed hash index");
+        }
+
+        for (std::size_t i = 0; i < hdr.name_count; ++i) {
+            auto rec = read<name_record>(blob, hdr.names_offset + i * sizeof(name_record));
+            check_string(blob, rec.name);
+            check_string(blob, read<string_ref>(blob, hdr.helps_offset + i * sizeof(string_ref)));
+            if (rec.callback >= callbacks) {
+                throw std::invalid_argument("cli_parser snapshot has a name without a callback");
+            }
+            if (rec.type >= hdr.type_count) {
+                throw std::invalid_argument("cli_parser snapshot has a name without a type");
+            }
+        }
+
+        for (std::size_t i = 0; i < hdr.type_count; ++i) {
+            auto rec = read<type_record>(blob, hdr.types_offset + i * sizeof(type_record));
+            check_string(blob, rec.default_val);
+            check_string(blob, rec.type_name);
+            if (rec.expected_type > static_cast<std::uint8_t>(cli::parse_type::any)) {
+                throw std::invalid_argument("cli_parser snapshot has an unknown parse type");
+            }
+        }
+    }
+}
+
+INFO_CLI_INLINE std::string
+info::cli::cli_parser::snapshot() const {
+    if (!_operand_slots.empty()) {
+        throw std::logic_error("cli_parser snapshots cannot store operand slots");
+    }
+    if (!_snapshot.empty()) {
+        return std::string(_snapshot);
+    }
+    return serialize();
+}
+
+INFO_CLI_INLINE void
+info::cli::cli_parser::freeze() {
+    if (!_snapshot.empty()) {
+        return;
+    }
+
+    auto blob = serialize();
+    _slab.resize((blob.size() + sizeof(frozen_block) - 1) / sizeof(frozen_block));
+    std::memcpy(_slab.data(), blob.data(), blob.size());
+    _snapshot = std::string_view(reinterpret_cast<const char*>(_slab.data()), blob.size());
+
+    // the callbacks, and everything indexed by the ids of the options, stay
+    options_type{_resource}.swap(_options);
+    std::pmr::unordered_set<help_type>{_resource}.swap(_helps);
+    std::pmr::vector<std::string_view>{_resource}.swap(_prefix_index);
+}
+
+INFO_CLI_INLINE std::string
+info::cli::cli_parser::serialize() const {
+    namespace ss = _cli::snapshot;
+
+    auto helps = help_map();
+
+    ss::string_table strings;
+    std::vector<ss::type_record> types;
+    std::map<std::tuple<bool, std::string_view, int, parse_type, std::string_view>,
+             std::uint8_t>
+           type_idx;
+    std::vector<ss::name_record> names;
+    names.reserve(_prefix_index.size());
+    std::vector<ss::string_ref> help_refs;
+    help_refs.reserve(_prefix_index.size());
+
+    // names first, so the strings compared during lookups are close to each other
+    for (auto name : _prefix_index) {
+        names.push_back({strings.add(name), 0, 0, {0, 0, 0}});
+    }
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        auto name = _prefix_index[i];
+        const auto& [data, callback] = _options.find(name)->second;
+
+        auto key = std::make_tuple(data.allow_nothing,
+                                   data.default_val,
+                                   data.length,
+                                   data.expected_type,
+                                   data.type_name);
+        auto it = type_idx.find(key);
+        if (it == type_idx.end()) {
+            if (types.size() == ss::max_types) {
+                throw std::length_error("cli_parser snapshots cannot store more than 256 distinct option types");
+            }
+            it = type_idx.emplace(key, static_cast<std::uint8_t>(types.size())).first;
+            types.push_back({strings.add(data.default_val),
+                             strings.add(data.type_name),
+                             data.length,
+                             static_cast<std::uint8_t>(data.allow_nothing),
+                             static_cast<std::uint8_t>(data.expected_type),
+                             {0, 0}});
+        }
+        names[i].callback = static_cast<std::uint32_t>(callback);
+        names[i].type = it->second;
+
+        auto help = helps.find(name);
+        help_refs.push_back(strings.add(help == helps.end() ? std::string_view{} : help->second));
+    }
+
+    // open addressing at most half full, so probe sequences stay short
+    std::uint32_t slot_count = 1;
+    while (slot_count <= 2 * names.size()) {
+        slot_count <<= 1;
+    }
+    std::vector<ss::hash_slot> slots(slot_count, ss::hash_slot{0, 0});
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        auto hash = ss::hash(_prefix_index[i]);
+        auto slot = hash & (slot_count - 1);
+        while (slots[slot].name != 0) {
+            slot = (slot + 1) & (slot_count - 1);
+        }
+        slots[slot] = {hash, static_cast<std::uint32_t>(i + 1)};
+    }
+
+    ss::header hdr{};
+    std::copy(std::begin(ss::magic), std::end(ss::magic), hdr.magic);
+    hdr.version = ss::version;
+    hdr.byte_order = ss::byte_order;
+    hdr.flags = _auto_help ? ss::has_auto_help : 0u;
+    hdr.callback_count = static_cast<std::uint32_t>(_callbacks.size() - (_auto_help ? 1 : 0));
+    hdr.name_count = static_cast<std::uint32_t>(names.size());
+    hdr.type_count = static_cast<std::uint32_t>(types.size());
+    hdr.slot_count = slot_count;
+    hdr.slots_offset = sizeof(ss::header);
+    hdr.names_offset = hdr.slots_offset
+                       + static_cast<std::uint32_t>(slots.size() * sizeof(ss::hash_slot));
+    hdr.types_offset = hdr.names_offset
+                       + static_cast<std::uint32_t>(names.size() * sizeof(ss::name_record));
+    hdr.helps_offset = hdr.types_offset
+                       + static_cast<std::uint32_t>(types.size() * sizeof(ss::type_record));
+    hdr.usage_options = strings.add(_auto_help ? usage_options() : std::string{});
+    hdr.options_help = strings.add(_auto_help ? options_help() : std::string{});
+
+    auto base = hdr.helps_offset + help_refs.size() * sizeof(ss::string_ref);
+    hdr.blob_size = static_cast<std::uint32_t>(base + strings.data.size());
+    ss::relocate(hdr.usage_options, base);
+    ss::relocate(hdr.options_help, base);
+
+    std::string blob;
+    blob.reserve(hdr.blob_size);
+    ss::append(blob, hdr);
+    for (auto slot : slots) {
+        ss::append(blob, slot);
+    }
+    for (auto rec : names) {
+        ss::relocate(rec.name, base);
+        ss::append(blob, rec);
+    }
+    for (auto rec : types) {
+        ss::relocate(rec.default_val, base);
+        ss::relocate(rec.type_name, base);
+        ss::append(blob, rec);
+    }
+    for (auto ref : help_refs) {
+        ss::relocate(ref, base);
+        ss::append(blob, ref);
+    }
+    blob += strings.data;
+    return blob;
+}
+
+INFO_CLI_INLINE
+info::cli::cli_parser::cli_parser(from_snapshot_t,
+                                  std::string_view blob,
+                                  std::vector<std::function<option::callback_type>> callbacks)
+     : _callbacks(std::make_move_iterator(callbacks.begin()),
+                  std::make_move_iterator(callbacks.end()),
+                  _resource),
+       _snapshot(blob) {
+    namespace ss = _cli::snapshot;
+
+    if (blob.size() < sizeof(ss::header)) {
+        throw std::invalid_argument("cli_parser snapshot is truncated");
+    }
+
+    const auto hdr = ss::header_of(blob);
+    if (!std::equal(std::begin(ss::magic), std::end(ss::magic), hdr.magic)
+        || hdr.version != ss::version
+        || hdr.byte_order != ss::byte_order) {
+        throw std::invalid_argument("blob is not a cli_parser snapshot of this InfoCLI version");
+    }
+    if (hdr.blob_size != blob.size()
+        || hdr.slots_offset + std::uint64_t{hdr.slot_count} * sizeof(ss::hash_slot) > blob.size()
+        || hdr.names_offset + std::uint64_t{hdr.name_count} * sizeof(ss::name_record) > blob.size()
+        || hdr.types_offset + std::uint64_t{hdr.type_count} * sizeof(ss::type_record) > blob.size()
+        || hdr.helps_offset + std::uint64_t{hdr.name_count} * sizeof(ss::string_ref) > blob.size()) {
+        throw std::invalid_argument("cli_parser snapshot is truncated");
+    }
+    if (hdr.slot_count <= hdr.name_count
+        || (hdr.slot_count & (hdr.slot_count - 1)) != 0) {
+        throw std::invalid_argument("cli_parser snapshot has a malformed hash index");
+    }
+    if (_callbacks.size() != hdr.callback_count) {
+        throw std::invalid_argument("the amount of callbacks does not match the cli_parser snapshot");
+    }
+
+    if (hdr.flags & ss::has_auto_help) {
+        _auto_help = true;
+        _callbacks.emplace_back([](std::string_view, const char*&) {// printed by call
+            return true;
+        });
+    }
+    ss::validate(blob, hdr, _callbacks.size());
+}
+
+INFO_CLI_INLINE std::optional<info::cli::cli_parser::option_info>
+info::cli::cli_parser::find_snapshot_option(std::string_view name) const {
+    namespace ss = _cli::snapshot;
+
+    const auto hdr = ss::header_of(_snapshot);
+    const auto hash = ss::hash(name);
+    const auto mask = hdr.slot_count - 1;
+
+    // at most half full, so the probing ends at an empty slot; bounded all the same
+    for (std::uint32_t probe = 0, slot = hash & mask; probe < hdr.slot_count; ++probe, slot = (slot + 1) & mask) {
+        auto entry = ss::read<ss::hash_slot>(_snapshot,
+                                             hdr.slots_offset + slot * sizeof(ss::hash_slot));
+        if (entry.name == 0) {
+            break;
+        }
+        if (entry.hash != hash) {
+            continue;
+        }
+        auto rec = ss::read<ss::name_record>(_snapshot,
+                                             hdr.names_offset + (entry.name - 1) * sizeof(ss::name_record));
+        if (ss::string(_snapshot, rec.name) != name) {
+            continue;
+        }
+
+        auto type = ss::read<ss::type_record>(_snapshot,
+                                              hdr.types_offset + rec.type * sizeof(ss::type_record));
+        return option_info{rt_type_data(type.allow_nothing != 0,
+                                        ss::string(_snapshot, type.default_val),
+                                        type.length,
+                                        static_cast<parse_type>(type.expected_type),
+                                        ss::string(_snapshot, type.type_name)),
+                           rec.callback};
+    }
+    return std::nullopt;
+}
+
+INFO_CLI_INLINE std::string_view
+info::cli::cli_parser::snapshot_help(bool usage) const {
+    namespace ss = _cli::snapshot;
+
+    const auto hdr = ss::header_of(_snapshot);
+    return ss::string(_snapshot, usage ? hdr.usage_options : hdr.options_help);
+}
+
+INFO_CLI_INLINE std::size_t
+info::cli::cli_parser::snapshot_name_count() const noexcept {
+    namespace ss = _cli::snapshot;
+
+    return ss::header_of(_snapshot).name_count;
+}
+
+INFO_CLI_INLINE std::string_view
+info::cli::cli_parser::snapshot_name(std::size_t idx) const noexcept {
+    namespace ss = _cli::snapshot;
+
+    const auto hdr = ss::header_of(_snapshot);
+    auto rec = ss::read<ss::name_record>(_snapshot,
+                                         hdr.names_offset + idx * sizeof(ss::name_record));
+    return ss::string(_snapshot, rec.name);
+}
+
+INFO_CLI_INLINE std::string_view
+info::cli::cli_parser::snapshot_option_help(std::size_t idx) const noexcept {
+    namespace ss = _cli::snapshot;
+
+    const auto hdr = ss::header_of(_snapshot);
+    auto help = ss::read<ss::string_ref>(_snapshot,
+                                         hdr.helps_offset + idx * sizeof(ss::string_ref));
+    return ss::string(_snapshot, help);
+}
+
+#if INFO_CLI_HAS_MMAP
+INFO_CLI_INLINE
+info::cli::mapped_snapshot::mapped_snapshot(const char* path) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) == -1) {
+        auto err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), path);
+    }
+
+    _size = static_cast<std::size_t>(st.st_size);
+    if (_size != 0) {
+        auto addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            auto err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), path);
+        }
+        _data = static_cast<const char*>(addr);
+    }
+    ::close(fd);
+}
+
+INFO_CLI_INLINE
+info::cli::mapped_snapshot::~mapped_snapshot() {
+    if (_data != nullptr) {
+        ::munmap(const_cast<char*>(_data), _size);
+    }
+}
+#else
+INFO_CLI_INLINE
+info::cli::mapped_snapshot::mapped_snapshot(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), path);
+    }
+    _fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    _data = _fallback.data();
+    _size = _fallback.size();
+}
+
+INFO_CLI_INLINE
+info::cli::mapped_snapshot::~mapped_snapshot() = default;
+#endif
@@ -9,29 +9,29 @@
 
 #include <cctype>
 
-bool
+INFO_CLI_INLINE bool
 info::cli::rt_type_data::finite() const noexcept {
     return length != -1;
 }
 
-std::function<bool(char)>
+INFO_CLI_INLINE std::function<bool(char)>
 info::cli::parse_type_accepts(info::cli::parse_type type) {
     switch (type) {
     case parse_type::alpha:
         return [](char ch) {
-            return std::isalpha(ch);
+            return std::isalpha(static_cast<unsigned char>(ch)) != 0;
         };
     case parse_type::alphanumeric:
         return [](char ch) {
-            return std::isalnum(ch);
+            return std::isalnum(static_cast<unsigned char>(ch)) != 0;
         };
     case parse_type::numeric:
         return [](char ch) {
-            return std::isdigit(ch);
+            return std::isdigit(static_cast<unsigned char>(ch)) != 0;
         };
     case parse_type::printable:
         return [](char ch) {
-            return std::isprint(ch);
+            return std::isprint(static_cast<unsigned char>(ch)) != 0;
         };
     case parse_type::any:
         return [](char) {
@@ -7,16 +7,15 @@
 
 #include <info/cli/types/type_parser.hxx>
 
-#include <cassert>
 
-info::expected<std::string, info::cli::parser_opcode>
+INFO_CLI_INLINE info::expected<std::string, info::cli::parser_opcode>
 info::cli::type_parser<std::string>::operator()(std::string_view str,
                                                 const char*& last) const noexcept {
     last = str.data() + str.size();
     return std::string(str.data(), str.size());
 }
 
-info::expected<std::string_view, info::cli::parser_opcode>
+INFO_CLI_INLINE info::expected<std::string_view, info::cli::parser_opcode>
 info::cli::type_parser<std::string_view>::operator()(std::string_view str,
                                                      const char*& last) const noexcept {
     last = str.data() + str.size();
@@ -24,11 +23,9 @@ info::cli::type_parser<std::string_view>::operator()(std::string_view str,
 }
 
 #define INTEGRAL_PARSER_IMPL(T)                                               \
-    info::expected<T, info::cli::parser_opcode>                               \
+    INFO_CLI_INLINE info::expected<T, info::cli::parser_opcode>               \
     info::cli::type_parser<T>::operator()(std::string_view str,               \
                                           const char*& last) const noexcept { \
-        assert(!str.empty());                                                 \
-                                                                              \
         T i;                                                                  \
         auto [p, ex] = std::from_chars(str.data(),                            \
                                        str.data() + str.size(),               \
@@ -51,29 +48,32 @@ INTEGRAL_PARSER_IMPL(unsigned long)
 INTEGRAL_PARSER_IMPL(long long)
 INTEGRAL_PARSER_IMPL(long unsigned long)
 
-info::expected<char, info::cli::parser_opcode>
+INFO_CLI_INLINE info::expected<char, info::cli::parser_opcode>
 info::cli::type_parser<char>::operator()(std::string_view str,
                                          const char*& last) const noexcept {
-    assert(str.size() == 1);
+    if (str.empty())// --char= gives nothing
+        return INFO_UNEXPECTED{parser_opcode::terminate};
 
     last = str.data() + 1;
     return str[0];
 }
 
-info::expected<unsigned char, info::cli::parser_opcode>
+INFO_CLI_INLINE info::expected<unsigned char, info::cli::parser_opcode>
 info::cli::type_parser<unsigned char>::operator()(std::string_view str,
                                                   const char*& last) const noexcept {
-    assert(str.size() == 1);
+    if (str.empty())// --char= gives nothing
+        return INFO_UNEXPECTED{parser_opcode::terminate};
 
     last = str.data() + 1;
     return static_cast<unsigned char>(str[0]);
 }
 
 // ah, yes copy-paste oriented programming
-info::expected<float, info::cli::parser_opcode>
+INFO_CLI_INLINE info::expected<float, info::cli::parser_opcode>
 info::cli::type_parser<float>::operator()(std::string_view str,
                                           const char*& last) const noexcept {
-    assert(!str.empty());
+    if (str.empty())
+        return INFO_UNEXPECTED{parser_opcode::terminate};
 
     auto val = std::strtof(str.data(), const_cast<char**>(&last));
     if (str.data() == last)// couldn't parse shit
@@ -81,10 +81,11 @@ info::cli::type_parser<float>::operator()(std::string_view str,
     return val;
 }
 
-info::expected<double, info::cli::parser_opcode>
+INFO_CLI_INLINE info::expected<double, info::cli::parser_opcode>
 info::cli::type_parser<double>::operator()(std::string_view str,
                                            const char*& last) const noexcept {
-    assert(!str.empty());
+    if (str.empty())
+        return INFO_UNEXPECTED{parser_opcode::terminate};
 
     auto val = std::strtod(str.data(), const_cast<char**>(&last));
     if (str.data() == last)// couldn't parse shit
@@ -92,10 +93,11 @@ info::cli::type_parser<double>::operator()(std::string_view str,
     return val;
 }
 
-info::expected<long double, info::cli::parser_opcode>
+INFO_CLI_INLINE info::expected<long double, info::cli::parser_opcode>
 info::cli::type_parser<long double>::operator()(std::string_view str,
                                                 const char*& last) const noexcept {
-    assert(!str.empty());
+    if (str.empty())
+        return INFO_UNEXPECTED{parser_opcode::terminate};
 
     auto val = std::strtold(str.data(), const_cast<char**>(&last));
     if (str.data() == last)// couldn't parse shit
@@ -103,7 +105,7 @@ info::cli::type_parser<long double>::operator()(std::string_view str,
     return val;
 }
 
-info::expected<bool, info::cli::parser_opcode>
+INFO_CLI_INLINE info::expected<bool, info::cli::parser_opcode>
 info::cli::type_parser<bool>::operator()(std::string_view str,
                                          const char*& last) const noexcept {
     if (str.empty())
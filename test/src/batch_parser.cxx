@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for parsing batches of command lines into columns
+ */
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/batch_parser.hxx>
+#include <info/cli/cli_parser.hxx>
+using namespace info::cli::udl;
+namespace ic = info::cli;
+
+TEST_CASE("batch_parser parses lines into columns",
+          "[batch_parser]") {
+    int j = 0;
+    bool v = false;
+    std::string name;
+    ic::cli_parser schema{
+           'j'_opt / "jobs" >>= j,
+           'v'_opt >>= v,
+           "name"_opt >>= name};
+    ic::batch_parser batch(schema);
+    const auto& jobs = batch.add_column<int>("jobs");
+    const auto& names = batch.add_column<std::string>("name");
+
+    batch({"make\0-j4\0all\0"sv,
+           "make\0-vj\00012\0"sv,
+           "make\0--name=x\0a\0b\0"sv,
+           "make\0--nope\0"sv});
+
+    CHECK(jobs.given(0));
+    CHECK(jobs.values[0] == 4);
+    CHECK(jobs.given(1));
+    CHECK(jobs.values[1] == 12);
+    CHECK_FALSE(jobs.given(2));
+    CHECK(jobs.values[2] == 0);
+    CHECK_FALSE(names.given(0));
+    CHECK(names.given(2));
+    CHECK(names.values[2] == "x");
+    CHECK_FALSE(jobs.given(3));
+
+    const auto& ops = batch.operands();
+    CHECK_THAT(ops.offsets, Catch::Equals(std::vector<std::size_t>{0, 2, 3, 6, 6}));
+    CHECK_THAT(ops.values, Catch::Equals(std::vector{"make"sv, "all"sv, "make"sv, "make"sv, "a"sv, "b"sv}));
+
+    REQUIRE(batch.errors().size() == 1);
+    CHECK(batch.errors()[0].line == 3);
+    CHECK_FALSE(batch.errors()[0].message.empty());
+    CHECK(j == 0);
+    CHECK_FALSE(v);
+}
+
+TEST_CASE("batch_parser parses many blocks on many threads",
+          "[batch_parser]") {
+    int j = 0;
+    ic::cli_parser schema{
+           'j'_opt / "jobs" >>= j,
+           'v'_opt >>= j};
+    ic::batch_parser batch(schema);
+    batch.threads(4);
+    const auto& jobs = batch.add_column<int>("j");
+
+    std::vector<std::string> storage;
+    for (std::size_t i = 0; i < 5000u; ++i) {
+        if (i % 7u == 0u) {
+            storage.push_back("x\0-v3\0op\0"s);
+        } else if (i % 100u == 99u) {
+            storage.push_back("x\0-j\0"s);
+        } else {
+            storage.push_back("x\0--jobs\0"s + std::to_string(i) + '\0');
+        }
+    }
+    std::vector<std::string_view> lines(storage.begin(), storage.end());
+    batch(lines);
+
+    std::size_t errors = 0;
+    for (std::size_t i = 0; i < 5000u; ++i) {
+        if (i % 7u == 0u) {
+            CHECK_FALSE(jobs.given(i));
+        } else if (i % 100u == 99u) {
+            CHECK_FALSE(jobs.given(i));
+            REQUIRE(errors < batch.errors().size());
+            CHECK(batch.errors()[errors++].line == i);
+        } else {
+            REQUIRE(jobs.given(i));
+            CHECK(jobs.values[i] == static_cast<int>(i));
+        }
+        auto ops = batch.operands().offsets[i + 1] - batch.operands().offsets[i];
+        CHECK(ops == (i % 7u == 0u ? 2u : i % 100u == 99u ? 0u : 1u));
+    }
+    CHECK(errors == batch.errors().size());
+
+    batch({});
+    CHECK(jobs.values.empty());
+    CHECK(batch.errors().empty());
+    CHECK_THAT(batch.operands().offsets, Catch::Equals(std::vector<std::size_t>{0}));
+}
+
+TEST_CASE("batch_parser reports the errors of many threads",
+          "[batch_parser]") {
+    int j = 0;
+    ic::cli_parser schema{'j'_opt >>= j};
+    ic::batch_parser batch(schema);
+    batch.threads(8);
+
+    std::vector<std::string> storage;
+    for (std::size_t i = 0; i < 20000u; ++i) {
+        storage.push_back("t\0--nope"s + std::to_string(i) + '\0');
+    }
+    std::vector<std::string_view> lines(storage.begin(), storage.end());
+    batch(lines);
+
+    REQUIRE(batch.errors().size() == lines.size());
+    std::size_t mismatched = 0;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        const auto& error = batch.errors()[i];
+        CHECK(error.line == i);
+        if (error.message.find("nope"s + std::to_string(i) + '\'') == std::string::npos) {
+            ++mismatched;
+        }
+    }
+    CHECK(mismatched == 0u);
+}
+
+TEST_CASE("batch_parser rejects bad columns",
+          "[batch_parser]") {
+    int j = 0;
+    ic::cli_parser schema{'j'_opt / "jobs" >>= j};
+    ic::batch_parser batch(schema);
+
+    CHECK_THROWS_AS(batch.add_column<int>("nope"), std::invalid_argument);
+    CHECK_THROWS_AS(batch.add_column<int>("help"), std::invalid_argument);
+    batch.add_column<int>("j");
+    CHECK_THROWS_AS(batch.add_column<int>("jobs"), std::invalid_argument);
+}
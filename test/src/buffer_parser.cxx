@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for parsing NUL-separated buffers of arguments
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/buffer_parser.hxx>
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+using namespace info::cli::udl;
+namespace ic = info::cli;
+
+TEST_CASE("cli_parser parses NUL-separated buffers in place",
+          "[cli_parser][buffer_parser]") {
+    int i = 0;
+    bool b = false;
+    std::string s;
+    ic::cli_parser cli{
+           'i'_opt / "int" >>= i,
+           'b'_opt >>= b,
+           "str"_opt >>= s};
+
+    auto buffer = "/usr/bin/tool\0-bi42\0--str\0value\0file\0"sv;
+    auto ops = cli(buffer);
+
+    CHECK_THAT(ops, Catch::Equals(std::vector{"/usr/bin/tool"sv, "file"sv}));
+    CHECK(ops[1].data() == buffer.data() + buffer.find("file"));
+    CHECK(i == 42);
+    CHECK(b);
+    CHECK(s == "value");
+}
+
+TEST_CASE("cli_parser parses buffers without the last NUL",
+          "[cli_parser][buffer_parser]") {
+    int i = 0;
+    ic::cli_parser cli{'i'_opt >>= i};
+
+    auto value = "tool\0-i\0005"sv;
+    CHECK_THAT(cli(value), Catch::Equals(std::vector{"tool"sv}));
+    CHECK(i == 5);
+
+    auto operand = "tool\0-i7\0op"sv;
+    auto ops = cli(operand);
+    CHECK_THAT(ops, Catch::Equals(std::vector{"tool"sv, "op"sv}));
+    CHECK(ops[1].data() == operand.data() + operand.size() - 2);
+    CHECK(i == 7);
+
+    CHECK(cli(""sv).empty());
+}
+
+TEST_CASE("buffer_parser parses many buffers with one parser",
+          "[cli_parser][buffer_parser]") {
+    int i = 0;
+    ic::cli_parser cli{'i'_opt / "int" >>= i};
+    ic::buffer_parser parse(cli);
+
+    CHECK_THAT(parse("a\0-i1\0x\0y\0"sv), Catch::Equals(std::vector{"a"sv, "x"sv, "y"sv}));
+    CHECK(i == 1);
+    CHECK_THAT(parse("b\0--int=2\0"sv), Catch::Equals(std::vector{"b"sv}));
+    CHECK(i == 2);
+    CHECK_THROWS_AS(parse("c\0--nope\0"sv), ic::no_such_option);
+    CHECK_THAT(parse("d\0--\0-i\0"sv), Catch::Equals(std::vector{"d"sv, "-i"sv}));
+    CHECK_THAT(parse("e\0__complete\0"sv), Catch::Equals(std::vector{"e"sv, "__complete"sv}));
+}
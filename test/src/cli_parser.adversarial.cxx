@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for hostile command lines: these have to be handled in linear time,
+ * without the stack growing with the input
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/exc/callback_error.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+using namespace info::cli::udl;
+
+namespace {
+    constexpr const std::size_t huge = 1'000'000;
+
+    struct owned_args {
+        explicit owned_args(std::vector<std::string> args)
+             : strings(std::move(args)) {
+            for (auto& str : strings) {
+                ptrs.push_back(str.data());
+            }
+        }
+
+        std::vector<std::string> strings;
+        std::vector<char*> ptrs;
+    };
+}
+
+TEST_CASE("cli_parser handles a packed group of a million options without recursion",
+          "[cli_parser][adversarial][packed]") {
+    int v = 0;
+    info::cli::cli_parser cli{
+           'v'_opt >>= info::cli::repeat{v}};
+    owned_args args({"text", "-" + std::string(huge, 'v')});
+
+    auto rem = cli(args.ptrs.size(), args.ptrs.data());
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"text"sv}));
+    CHECK(v == static_cast<int>(huge));
+}
+
+TEST_CASE("cli_parser handles a long packed group of valued options",
+          "[cli_parser][adversarial][packed]") {
+    std::vector<int> is;
+    info::cli::cli_parser cli{
+           'i'_opt >>= is};
+    std::string group = "-";
+    for (std::size_t i = 0; i < huge / 4; ++i) {
+        group += "i42";
+    }
+    owned_args args({"text", group});
+
+    cli(args.ptrs.size(), args.ptrs.data());
+
+    CHECK(is.size() == huge / 4);
+    CHECK(is.back() == 42);
+}
+
+TEST_CASE("cli_parser handles a million arguments",
+          "[cli_parser][adversarial]") {
+    int v = 0;
+    info::cli::cli_parser cli{
+           'v'_opt >>= info::cli::repeat{v}};
+    std::vector<std::string> strs{"text"};
+    for (std::size_t i = 0; i < huge; ++i) {
+        strs.emplace_back(i % 2 == 0 ? "-v" : "op");
+    }
+    owned_args args(std::move(strs));
+
+    auto rem = cli(args.ptrs.size(), args.ptrs.data());
+
+    CHECK(rem.size() == huge / 2 + 1);
+    CHECK(v == static_cast<int>(huge / 2));
+}
+
+TEST_CASE("cli_parser passes back megabyte long unknown option names",
+          "[cli_parser][adversarial][long_options]") {
+    std::string str;
+    info::cli::cli_parser cli{
+           "str"_opt >>= str};
+    cli.unknown_behavior(info::cli::unknown_behavior::pass_back);
+    auto name = "--" + std::string(huge, 's');
+    owned_args args({"text", name, "--str=" + std::string(huge, 'x')});
+
+    auto rem = cli(args.ptrs.size(), args.ptrs.data());
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"text"sv, std::string_view(name)}));
+    CHECK(str.size() == huge);
+}
+
+TEST_CASE("cli_parser rejects empty and non-ASCII values without reading out of bounds",
+          "[cli_parser][adversarial]") {
+    char c = '\0';
+    int i = 0;
+    info::cli::cli_parser cli{
+           'c'_opt / "char" >>= c,
+           'i'_opt / "int" >>= i};
+
+    SECTION("empty arguments are operands") {
+        owned_args args({"text", "", "-"});
+        auto rem = cli(args.ptrs.size(), args.ptrs.data());
+        CHECK_THAT(rem, Catch::Equals(std::vector{"text"sv, ""sv, "-"sv}));
+    }
+    SECTION("empty GNU-style values fail the callback") {
+        owned_args args({"text", "--char="});
+        CHECK_THROWS_AS(cli(args.ptrs.size(), args.ptrs.data()), info::cli::callback_error);
+
+        owned_args args2({"text", "--int="});
+        CHECK_THROWS_AS(cli(args2.ptrs.size(), args2.ptrs.data()), info::cli::callback_error);
+    }
+    SECTION("high bytes in packed groups") {
+        owned_args args({"text", "-\xff\xfe"});
+        CHECK_THROWS_AS(cli(args.ptrs.size(), args.ptrs.data()), info::cli::no_such_option);
+
+        owned_args args2({"text", "-i\xff"});
+        CHECK_THROWS_AS(cli(args2.ptrs.size(), args2.ptrs.data()), info::cli::bad_option_value);
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for options aggregating into maps and sets
+ */
+
+#include <array>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/callback_error.hxx>
+using namespace info::cli::udl;
+
+TEST_CASE("cli_parser aggregates KEY=VALUE options into maps",
+          "[cli_parser][aggregator][associative]") {
+    std::map<std::string, int> levels;
+    std::unordered_map<std::string_view, std::string_view> defines;
+    info::cli::cli_parser cli{
+           'O'_opt / "level" >>= levels,
+           'D'_opt / "define" >>= defines};
+    auto args = std::array{"text",
+                           "-D", "NDEBUG=1",
+                           "--define=NAME=value=x",
+                           "-Oopt=2",
+                           "--level", "size=1",
+                           "-Oopt=3"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"text"sv}));
+    CHECK(levels == std::map<std::string, int>{{"opt", 3}, {"size", 1}});
+    REQUIRE(defines.size() == 2);
+    CHECK(defines["NDEBUG"] == "1");
+    CHECK(defines["NAME"] == "value=x");
+    CHECK(defines["NDEBUG"].data() == args[2] + 7);// views of the argument, no copies
+}
+
+TEST_CASE("cli_parser aggregates options into sets",
+          "[cli_parser][aggregator][associative]") {
+    std::set<int> ports;
+    std::unordered_set<std::string> tags;
+    info::cli::cli_parser cli{
+           'p'_opt >>= ports,
+           "tag"_opt >>= tags};
+    auto args = std::array{"text", "-p80", "-p", "443", "-p80", "--tag=a", "--tag", "b"};
+
+    cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK(ports == std::set<int>{80, 443});
+    CHECK(tags == std::unordered_set<std::string>{"a", "b"});
+}
+
+TEST_CASE("cli_parser fails on malformed KEY=VALUE options",
+          "[cli_parser][aggregator][associative]") {
+    std::map<std::string, int> levels;
+    info::cli::cli_parser cli{
+           'O'_opt >>= levels};
+
+    auto no_eq = std::array{"text", "-O", "opt"};
+    CHECK_THROWS_AS(cli(no_eq.size(), const_cast<char**>(no_eq.data())),
+                    info::cli::callback_error);
+
+    auto bad_value = std::array{"text", "-O", "opt=x"};
+    CHECK_THROWS_AS(cli(bad_value.size(), const_cast<char**>(bad_value.data())),
+                    info::cli::callback_error);
+}
+
+TEST_CASE("cli_parser handles duplicate keys by the chosen policy",
+          "[cli_parser][aggregator][associative][on_duplicate]") {
+    std::map<std::string, int> first;
+    std::unordered_map<std::string, int> rejecting;
+    std::set<int> rejecting_set;
+    info::cli::cli_parser cli{
+           'f'_opt >>= info::cli::on_duplicate<info::cli::duplicate_key::keep_first>(first),
+           'r'_opt >>= info::cli::on_duplicate<info::cli::duplicate_key::reject>(rejecting),
+           's'_opt >>= info::cli::on_duplicate<info::cli::duplicate_key::reject>(rejecting_set)};
+
+    SECTION("keep_first keeps the first value") {
+        auto args = std::array{"text", "-f", "a=1", "-f", "a=2", "-f", "b=3"};
+        cli(args.size(), const_cast<char**>(args.data()));
+        CHECK(first == std::map<std::string, int>{{"a", 1}, {"b", 3}});
+    }
+    SECTION("reject throws on a repeated key") {
+        auto args = std::array{"text", "-r", "a=1", "-r", "b=1", "-r", "a=2"};
+        CHECK_THROWS_AS(cli(args.size(), const_cast<char**>(args.data())),
+                        info::cli::callback_error);
+        CHECK(rejecting.at("a") == 1);
+    }
+    SECTION("reject throws on a repeated set element") {
+        auto args = std::array{"text", "-s1", "-s2", "-s1"};
+        CHECK_THROWS_AS(cli(args.size(), const_cast<char**>(args.data())),
+                        info::cli::callback_error);
+    }
+}
+
+TEST_CASE("presize reserves unordered maps",
+          "[cli_parser][aggregator][associative][presize]") {
+    std::unordered_map<std::string, std::string> defines;
+    info::cli::cli_parser cli{
+           'D'_opt >>= info::cli::on_duplicate<info::cli::duplicate_key::reject>(defines)};
+    cli.presize(true);
+
+    std::vector<std::string> strs{"text"};
+    for (int i = 0; i < 1000; ++i) {
+        strs.push_back("-DK" + std::to_string(i) + "=v");
+    }
+    std::vector<char*> args;
+    for (auto& str : strs) {
+        args.push_back(str.data());
+    }
+
+    auto buckets = [&] {
+        defines.clear();
+        defines.rehash(0);
+        cli(args.size(), args.data());
+        return defines.bucket_count();
+    }();
+
+    CHECK(defines.size() == 1000);
+    CHECK(buckets >= 1000);
+    std::unordered_map<std::string, std::string> reserved;
+    reserved.reserve(1000);
+    CHECK(buckets == reserved.bucket_count());// grown once, straight to the reserved size
+}
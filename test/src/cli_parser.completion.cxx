@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for the shell completion support of cli_parser
+ */
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/option.hxx>
+using namespace info::cli::udl;
+
+TEST_CASE("cli_parser completes long options by prefix",
+          "[cli_parser][completion]") {
+    int i;
+    bool b;
+    info::cli::cli_parser cli{
+           "output"_opt >>= i,
+           "outdir"_opt >>= i,
+           "verbose"_opt / 'v' >>= b};
+
+    CHECK_THAT(cli.complete("--out"), Catch::Equals(std::vector{"--outdir"s, "--output"s}));
+    CHECK_THAT(cli.complete("--outp"), Catch::Equals(std::vector{"--output"s}));
+    CHECK(cli.complete("--x").empty());
+    CHECK(cli.complete("--output=").empty());
+}
+
+TEST_CASE("cli_parser completes short options",
+          "[cli_parser][completion]") {
+    int i;
+    bool b;
+    info::cli::cli_parser cli{
+           'o'_opt >>= i,
+           "verbose"_opt / 'v' >>= b};
+
+    CHECK_THAT(cli.complete("-"), Catch::Equals(std::vector{"-o"s, "-v"s, "--verbose"s}));
+    CHECK_THAT(cli.complete("-v"), Catch::Equals(std::vector{"-v"s}));
+    CHECK(cli.complete("-vo").empty());
+}
+
+TEST_CASE("cli_parser does not complete operands",
+          "[cli_parser][completion]") {
+    int i;
+    info::cli::cli_parser cli{
+           "output"_opt >>= i};
+
+    CHECK(cli.complete("").empty());
+    CHECK(cli.complete("out").empty());
+}
+
+TEST_CASE("cli_parser only answers completion queries if enabled",
+          "[cli_parser][completion]") {
+    int i = 0;
+    info::cli::cli_parser cli{
+           "output"_opt >>= i};
+
+    auto args = std::array<const char*, 5>{"exec", "__complete", "--output", "4", nullptr};
+    auto rem = cli(args.size() - 1, const_cast<char**>(args.data()));
+
+    REQUIRE(rem.size() == 2);
+    CHECK(rem[1] == "__complete"sv);
+    CHECK(i == 4);
+}
+
+TEST_CASE("cli_parser generates static completion scripts",
+          "[cli_parser][completion][script]") {
+    int i;
+    bool b;
+    info::cli::cli_parser cli{
+           "output"_opt / 'o' >= "where it's written" >>= i,
+           'v'_opt >= "be [loud]" >>= b};
+
+    SECTION("bash") {
+        auto script = cli.completion_script(info::cli::shell::bash, "my-tool");
+        CHECK_THAT(script, Catch::Contains("complete -o default -F _my_tool_complete my-tool"));
+        CHECK_THAT(script, Catch::Contains("--output"));
+        CHECK_THAT(script, Catch::Contains("--help"));
+        CHECK_THAT(script, Catch::Contains("-o|--output) return 0"));
+    }
+
+    SECTION("zsh") {
+        auto script = cli.completion_script(info::cli::shell::zsh, "my-tool");
+        CHECK_THAT(script, Catch::StartsWith("#compdef my-tool\n"));
+        CHECK_THAT(script, Catch::Contains(R"('--output=[where it'\''s written]:int:')"));
+        CHECK_THAT(script, Catch::Contains(R"('-v[be \[loud\]]')"));
+    }
+
+    SECTION("fish") {
+        auto script = cli.completion_script(info::cli::shell::fish, "my-tool");
+        CHECK_THAT(script, Catch::Contains(R"(complete -c my-tool -l output -r -d 'where it\'s written')"));
+        CHECK_THAT(script, Catch::Contains("complete -c my-tool -s v -d 'be [loud]'"));
+    }
+}
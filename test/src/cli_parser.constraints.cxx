@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for the constraints between options
+ */
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/constraint_error.hxx>
+using namespace info::cli::udl;
+namespace ic = info::cli;
+
+namespace {
+    struct fixture {
+        bool a = false;
+        bool b = false;
+        bool c = false;
+        std::string out;
+        int x = 0;
+        int y = 0;
+        std::string file;
+        ic::cli_parser cli{
+               'a'_opt >>= a,
+               'b'_opt >>= b,
+               'c'_opt >>= c,
+               'o'_opt / "output" >>= out,
+               'x'_opt >>= x,
+               'y'_opt >>= y,
+               ic::operand("file") >>= file};
+
+        fixture() {
+            cli.constraints({ic::required("output", "file"),
+                             ic::exactly_one_of('a', 'b'),
+                             ic::mutually_exclusive('b', 'c'),
+                             ic::implies('x', 'y')});
+        }
+
+        template<std::size_t N>
+        std::vector<std::string>
+        violations(std::array<const char*, N> args) {
+            try {
+                cli(args.size(), const_cast<char**>(args.data()));
+            } catch (const ic::constraint_error& ex) {
+                return ex.violations;
+            }
+            return {};
+        }
+    };
+}
+
+TEST_CASE("satisfied constraints do not throw",
+          "[cli_parser][constraints]") {
+    fixture f;
+
+    CHECK(f.violations(std::array{"test", "-a", "-o", "out", "-x1", "-y2", "in"}).empty());
+    CHECK(f.violations(std::array{"test", "-b", "--output=out", "in"}).empty());
+}
+
+TEST_CASE("every violated constraint is reported at once",
+          "[cli_parser][constraints]") {
+    fixture f;
+
+    auto violations = f.violations(std::array{"test", "-b", "-c", "-x1"});
+
+    CHECK_THAT(violations, Catch::Equals(std::vector<std::string>{
+                                  "option '--output' is required",
+                                  "option '<file>' is required",
+                                  "'-b', '-c' cannot be given together",
+                                  "'-x' requires '-y'"}));
+}
+
+TEST_CASE("exactly one of rejects none and more",
+          "[cli_parser][constraints]") {
+    fixture f;
+
+    CHECK_THAT(f.violations(std::array{"test", "-o", "o", "in"}),
+               Catch::Equals(std::vector<std::string>{"exactly one of '-a', '-b' must be given"}));
+    CHECK_THAT(f.violations(std::array{"test", "-ab", "-o", "o", "in"}),
+               Catch::Equals(std::vector<std::string>{"exactly one of '-a', '-b' must be given"}));
+}
+
+TEST_CASE("constraints span more than one word of options",
+          "[cli_parser][constraints]") {
+    std::vector<ic::option> opts;
+    std::vector<int> vals(130);
+    for (std::size_t i = 0; i < vals.size(); ++i) {
+        opts.push_back(info::_cli::option_builder("opt" + std::to_string(i)) >>= vals[i]);
+    }
+    ic::cli_parser cli(std::move(opts));
+    cli.constraints({ic::exactly_one_of("opt3", "opt70", "opt129"),
+                     ic::implies("opt0", "opt64", "opt128")});
+    auto ok = std::array{"test", "--opt70=1"};
+    auto bad = std::array{"test", "--opt3=1", "--opt129=1", "--opt0=1", "--opt64=1"};
+
+    CHECK_NOTHROW(cli(ok.size(), const_cast<char**>(ok.data())));
+    try {
+        cli(bad.size(), const_cast<char**>(bad.data()));
+        FAIL("constraint_error not thrown");
+    } catch (const ic::constraint_error& ex) {
+        CHECK(ex.violations.size() == 2);
+    }
+}
+
+TEST_CASE("constraints on unknown options throw",
+          "[cli_parser][constraints]") {
+    bool a = false;
+    ic::cli_parser cli{'a'_opt >>= a};
+
+    CHECK_THROWS_AS(cli.constraints({ic::required("nope")}), std::invalid_argument);
+    CHECK_THROWS_AS(cli.constraints({ic::implies('a')}), std::invalid_argument);
+}
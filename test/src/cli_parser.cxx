@@ -7,8 +7,10 @@
 
 #include <algorithm>
 #include <array>
+#include <memory>
 #include <numeric>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 using namespace std::literals;
 
@@ -32,6 +34,51 @@ TEST_CASE("cli_parser takes init-list of options",
     CHECK(true);
 }
 
+TEST_CASE("cli_parser moves in options given as arguments or in a vector",
+          "[cli_parser][construction]") {
+    struct copy_counter {
+        int* copies;
+
+        copy_counter(int* copies) noexcept
+             : copies(copies) { }
+        copy_counter(const copy_counter& other) noexcept
+             : copies(other.copies) { ++*copies; }
+        copy_counter(copy_counter&&) noexcept = default;
+
+        void
+        operator()(std::string_view) const noexcept { }
+    };
+    int copies = 0;
+    int i = 0;
+    auto args = std::array{"test", "-i42", "--counted=x", "-W"};
+
+    SECTION("variadic") {
+        auto counted = "counted"_opt >= "counts copies" >>= copy_counter(&copies);
+        copies = 0;
+        info::cli::cli_parser cli('i'_opt / "int" >>= i,
+                                  std::move(counted),
+                                  'W' / "warn"_opt >= "warns" >>= [](bool) {});
+
+        CHECK(cli.size() == 7);// with help and h
+        cli(args.size(), const_cast<char**>(args.data()));
+        CHECK(i == 42);
+        CHECK(copies == 0);
+    }
+    SECTION("vector") {
+        std::vector<info::cli::option> opts;
+        opts.emplace_back('i'_opt / "int" >>= i);
+        opts.emplace_back("counted"_opt >= "counts copies" >>= copy_counter(&copies));
+        opts.emplace_back('W' / "warn"_opt >= "warns" >>= [](bool) {});
+        copies = 0;
+        info::cli::cli_parser cli(std::move(opts));
+
+        CHECK(cli.size() == 7);
+        cli(args.size(), const_cast<char**>(args.data()));
+        CHECK(i == 42);
+        CHECK(copies == 0);
+    }
+}
+
 TEST_CASE("cli_parser creates correct amount of actual options from the DSL",
           "[cli_parser][construction][dsl]") {
     int i, j, k;
@@ -122,6 +169,35 @@ TEST_CASE("repeat callback values allow incrementing valueless options",
     CHECK(i == 4);
 }
 
+TEST_CASE("presize reserves aggregating vectors once for all their values",
+          "[cli_parser][aggregator][presize]") {
+    std::vector<int> is;
+    std::vector<std::string_view> defs{"preexisting"};
+    bool b = false;
+    info::cli::cli_parser cli{
+           'i'_opt / "int" >>= is,
+           'D'_opt / "define" >>= defs,
+           'b'_opt >>= b};
+    cli.presize(true);
+    auto args = std::array{"text",
+                           "-i1",
+                           "--int", "2",
+                           "-bi", "3",
+                           "--int=4",
+                           "-DX",
+                           "--define", "-i",
+                           "--",
+                           "-i5"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"text"sv, "-i5"sv}));
+    CHECK_THAT(is, Catch::Equals(std::vector{1, 2, 3, 4}));
+    CHECK(is.capacity() == 4);
+    CHECK_THAT(defs, Catch::Equals(std::vector{"preexisting"sv, "X"sv, "-i"sv}));
+    CHECK(defs.capacity() == 3);
+}
+
 TEST_CASE("cli_parser handles - correctly",
           "[cli_parser][meta_options]") {
     int i = 0;
@@ -332,3 +408,21 @@ TEST_CASE("cli_parser returns it if option is not defined and pass_back is set",
         CHECK_THAT(rem, Catch::Equals(std::vector{"--tree=arbor"sv}));
     }
 }
+
+TEST_CASE("cli_parser is movable, but not copyable",
+          "[cli_parser][construction]") {
+    STATIC_REQUIRE_FALSE(std::is_copy_constructible_v<info::cli::cli_parser>);
+    STATIC_REQUIRE_FALSE(std::is_copy_assignable_v<info::cli::cli_parser>);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible_v<info::cli::cli_parser>);
+
+    int i = 0;
+    auto original = std::make_unique<info::cli::cli_parser>(
+           'i'_opt / "int" >= "an integer" >>= i);
+    info::cli::cli_parser moved(std::move(*original));
+    original.reset();
+
+    auto args = std::array{"test", "--int", "4", "op"};
+    auto rem = moved(args.size(), const_cast<char**>(args.data()));
+    CHECK_THAT(rem, Catch::Equals(std::vector{"test"sv, "op"sv}));
+    CHECK(i == 4);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for forwarding the arguments a parser does not know, compacted in argv
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+using namespace info::cli::udl;
+namespace ic = info::cli;
+
+namespace {
+    std::vector<std::string>
+    strings(char* const* argv) {
+        std::vector<std::string> ret;
+        for (; *argv != nullptr; ++argv) {
+            ret.emplace_back(*argv);
+        }
+        return ret;
+    }
+}
+
+TEST_CASE("cli_parser forwards unknown options with their values in place",
+          "[cli_parser][forwarding]") {
+    bool v = false;
+    std::string dir;
+    ic::cli_parser cli{
+           'v'_opt / "verbose" >>= v,
+           "cache-dir"_opt >>= dir};
+
+    auto args = std::array<const char*, 11>{"wrap", "-c", "x.c", "-v", "-o", "x.o", "--cache-dir", "/tmp", "--std=c17", "-", nullptr};
+    auto argv = const_cast<char**>(args.data());
+    int argc = static_cast<int>(args.size()) - 1;
+
+    auto forwarded = cli.forward(argc, argv);
+    CHECK(forwarded == argv);
+    CHECK(argc == 7);
+    CHECK_THAT(strings(forwarded),
+               Catch::Equals(std::vector{"wrap"s, "-c"s, "x.c"s, "-o"s, "x.o"s, "--std=c17"s, "-"s}));
+    CHECK(forwarded[2] == args[2]);
+    CHECK(v);
+    CHECK(dir == "/tmp");
+}
+
+TEST_CASE("cli_parser forwards everything after --, and the boundary",
+          "[cli_parser][forwarding]") {
+    bool v = false;
+    ic::cli_parser cli{'v'_opt >>= v};
+
+    auto args = std::array<const char*, 6>{"wrap", "-x", "--", "-v", "op", nullptr};
+    auto argv = const_cast<char**>(args.data());
+    int argc = static_cast<int>(args.size()) - 1;
+
+    cli.forward(argc, argv);
+    CHECK_THAT(strings(argv), Catch::Equals(std::vector{"wrap"s, "-x"s, "--"s, "-v"s, "op"s}));
+    CHECK(argc == 5);
+    CHECK_FALSE(v);
+}
+
+TEST_CASE("posix cli_parser forwarding stops at the first operand",
+          "[cli_parser][forwarding]") {
+    bool v = false;
+    int j = 0;
+    ic::cli_parser cli{
+           'v'_opt >>= v,
+           'j'_opt >>= j};
+
+    auto args = std::array<const char*, 8>{"wrap", "-vj", "4", "gcc", "-v", "-j2", "x.c", nullptr};
+    auto argv = const_cast<char**>(args.data());
+    int argc = static_cast<int>(args.size()) - 1;
+
+    cli.forward(argc, argv, ic::forwarding::posix);
+    CHECK_THAT(strings(argv), Catch::Equals(std::vector{"wrap"s, "gcc"s, "-v"s, "-j2"s, "x.c"s}));
+    CHECK(argc == 5);
+    CHECK(v);
+    CHECK(j == 4);
+}
+
+TEST_CASE("cli_parser only forwards during forward",
+          "[cli_parser][forwarding]") {
+    int j = 0;
+    ic::cli_parser cli{'j'_opt >>= j};
+
+    auto bad = std::array<const char*, 4>{"wrap", "-x", "-j", nullptr};
+    auto argv = const_cast<char**>(bad.data());
+    int argc = static_cast<int>(bad.size()) - 1;
+    CHECK_THROWS_AS(cli.forward(argc, argv), ic::bad_option_value);
+
+    auto args = std::array<const char*, 5>{"wrap", "-x", "--", "-j1", nullptr};
+    CHECK_THROWS(cli(args.size() - 1, const_cast<char**>(args.data())));
+}
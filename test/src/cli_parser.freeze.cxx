@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for freezing cli_parsers into their compact layout
+ */
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/exc/constraint_error.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+using namespace info::cli::udl;
+namespace ic = info::cli;
+
+namespace {
+    struct fixture {
+        int i = 0;
+        bool b = false;
+        std::string s;
+        std::vector<int> is;
+        ic::cli_parser cli{
+               'i'_opt / "int" >= "an int" >>= i,
+               'b'_opt / "bool" >= "a bool" >>= b,
+               "str"_opt >>= s,
+               'I'_opt / "ints" >>= is};
+    };
+}
+
+TEST_CASE("frozen cli_parser parses like before freezing",
+          "[cli_parser][freeze]") {
+    auto args = GENERATE(std::vector{"text", "-bi42", "--str", "value", "asd"},
+                         std::vector{"text", "--int=-3", "-I1", "--ints", "2", "--", "-b"},
+                         std::vector{"text", "--bool", "-I", "7", "--str=a=b", "-"});
+
+    fixture live;
+    auto live_rem = live.cli(args.size(), const_cast<char**>(args.data()));
+    fixture frozen;
+    frozen.cli.freeze();
+    auto frozen_rem = frozen.cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK(frozen_rem == live_rem);
+    CHECK(frozen.i == live.i);
+    CHECK(frozen.b == live.b);
+    CHECK(frozen.s == live.s);
+    CHECK(frozen.is == live.is);
+}
+
+TEST_CASE("frozen cli_parser keeps its names and help",
+          "[cli_parser][freeze]") {
+    fixture live;
+    fixture frozen;
+    frozen.cli.freeze();
+
+    CHECK(frozen.cli.size() == live.cli.size());
+    CHECK(frozen.cli.complete("--") == live.cli.complete("--"));
+    CHECK(frozen.cli.complete("--in") == live.cli.complete("--in"));
+    CHECK(frozen.cli.completion_script(ic::shell::zsh, "prog")
+          == live.cli.completion_script(ic::shell::zsh, "prog"));
+    CHECK(frozen.cli.snapshot() == live.cli.snapshot());
+}
+
+TEST_CASE("frozen cli_parser reports errors",
+          "[cli_parser][freeze]") {
+    fixture f;
+    f.cli.freeze();
+    f.cli.freeze();// no-op
+
+    auto unknown = std::array{"text", "--nope"};
+    CHECK_THROWS_AS(f.cli(unknown.size(), const_cast<char**>(unknown.data())),
+                    ic::no_such_option);
+    auto missing = std::array{"text", "--int"};
+    CHECK_THROWS_AS(f.cli(missing.size(), const_cast<char**>(missing.data())),
+                    ic::bad_option_value);
+}
+
+TEST_CASE("frozen cli_parser keeps operand slots and constraints",
+          "[cli_parser][freeze]") {
+    int x = 0;
+    bool v = false;
+    std::string file;
+    ic::cli_parser cli{
+           'x'_opt >>= x,
+           'v'_opt >>= v,
+           ic::operand("file") >= "The file" >>= file};
+    CHECK_THROWS_AS(cli.snapshot(), std::logic_error);
+    auto usage = cli.complete("-");
+    cli.freeze();
+    cli.constraints({ic::implies('x', 'v')});
+
+    CHECK(cli.complete("-") == usage);
+    CHECK_THROWS_AS(cli.snapshot(), std::logic_error);
+
+    auto bad = std::array{"text", "-x1", "a.txt"};
+    CHECK_THROWS_AS(cli(bad.size(), const_cast<char**>(bad.data())),
+                    ic::constraint_error);
+
+    auto good = std::array{"text", "-vx2", "b.txt"};
+    cli(good.size(), const_cast<char**>(good.data()));
+    CHECK(x == 2);
+    CHECK(v);
+    CHECK(file == "b.txt");
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for the lazy type modifier
+ */
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/extra/lazy.hxx>
+using namespace info::cli::udl;
+
+namespace {
+    int parses = 0;
+
+    // custom type counting how many times its parser is called
+    struct counted {
+        int i;
+    };
+}
+
+template<>
+struct info::cli::type_parser<counted> {
+    info::expected<counted, info::cli::parser_opcode>
+    operator()(std::string_view str, const char*& last) const noexcept {
+        ++parses;
+        last = str.data() + str.size();
+        return counted{static_cast<int>(str.size())};
+    }
+};
+
+TEST_CASE("lazy values are parsed on first access only",
+          "[cli_parser][lazy]") {
+    parses = 0;
+    info::cli::lazy<counted> c;
+    info::cli::cli_parser cli{
+           'c'_opt >>= c};
+    auto args = std::array{"test", "-c", "four", "-cxx"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"test"sv}));
+    CHECK(c.given());
+    CHECK_FALSE(c.parsed());
+    CHECK(c.source() == "xx");
+    CHECK(parses == 0);
+
+    CHECK(c->i == 2);
+    CHECK(c.get().i == 2);
+    CHECK((*c).i == 2);
+    CHECK(c.parsed());
+    CHECK(parses == 1);
+}
+
+TEST_CASE("lazy values keep their default if not given",
+          "[cli_parser][lazy]") {
+    info::cli::lazy<int> i = 42;
+    info::cli::lazy<std::string> s;
+    info::cli::cli_parser cli{
+           'i'_opt >>= i,
+           's'_opt >>= s};
+    auto args = std::array{"test", "operand"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"test"sv, "operand"sv}));
+    CHECK_FALSE(i.given());
+    CHECK(i.parsed());
+    CHECK(*i == 42);
+    CHECK_FALSE(s.given());
+    CHECK(s->empty());
+}
+
+TEST_CASE("lazy values aggregate every appearance",
+          "[cli_parser][lazy]") {
+    info::cli::lazy<std::vector<int>> is;
+    bool b = false;
+    info::cli::cli_parser cli{
+           'i'_opt / "int" >>= is,
+           'b'_opt >>= b};
+    auto args = std::array{"test", "-i", "1", "--int=2", "-bi3"};
+
+    cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK(b);
+    CHECK_THAT(*is, Catch::Equals(std::vector{1, 2, 3}));
+}
+
+TEST_CASE("lazy values report bad values on access",
+          "[cli_parser][lazy]") {
+    info::cli::lazy<int> i;
+    info::cli::cli_parser cli{
+           'i'_opt >>= i};
+    auto args = std::array{"test", "-i", "nope"};
+
+    CHECK_NOTHROW(cli(args.size(), const_cast<char**>(args.data())));
+    CHECK(i.source() == "nope");
+    CHECK_THROWS_AS(i.get(), info::cli::bad_option_value);
+    CHECK_FALSE(i.parsed());
+    try {
+        i.get();
+    } catch (const info::cli::bad_option_value& ex) {
+        CHECK(ex.opt_name == "i");
+    }
+}
+
+TEST_CASE("lazy values aggregate into their default",
+          "[cli_parser][lazy]") {
+    info::cli::lazy<std::vector<int>> is = std::vector{1, 2};
+    info::cli::cli_parser cli{
+           'i'_opt >>= is};
+    auto args = std::array{"test", "-i3", "-i4"};
+
+    cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(*is, Catch::Equals(std::vector{1, 2, 3, 4}));
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for matching long options regardless of case, dashes, and underscores
+ */
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+using namespace info::cli::udl;
+namespace ic = info::cli;
+
+TEST_CASE("folded cli_parser matches long options regardless of case and separators",
+          "[cli_parser][name_matching]") {
+    auto spelling = GENERATE("--output-dir"s, "--Output-Dir"s, "--output_dir"s, "--outputdir"s, "--OUTPUT__DIR"s);
+    auto frozen = GENERATE(false, true);
+
+    std::string dir;
+    bool v = false;
+    ic::cli_parser cli{
+           "output-dir"_opt >>= dir,
+           'v'_opt >>= v};
+    if (frozen) {
+        cli.freeze();
+    }
+    cli.name_matching(ic::name_matching::folded);
+
+    auto gnu = spelling + "=out";
+    auto args = std::array{"text", gnu.c_str(), "-v"};
+    cli(args.size(), const_cast<char**>(args.data()));
+    CHECK(dir == "out");
+    CHECK(v);
+
+    auto separate = std::array{"text", spelling.c_str(), "again"};
+    cli(separate.size(), const_cast<char**>(separate.data()));
+    CHECK(dir == "again");
+}
+
+TEST_CASE("folded cli_parser keeps short options case-sensitive",
+          "[cli_parser][name_matching]") {
+    bool lower = false;
+    bool upper = false;
+    ic::cli_parser cli{
+           'v'_opt >>= lower,
+           'V'_opt >>= upper};
+    cli.name_matching(ic::name_matching::folded);
+
+    auto args = std::array{"text", "-V"};
+    cli(args.size(), const_cast<char**>(args.data()));
+    CHECK(upper);
+    CHECK_FALSE(lower);
+}
+
+TEST_CASE("exact cli_parser does not fold names",
+          "[cli_parser][name_matching]") {
+    std::string dir;
+    ic::cli_parser cli{"output-dir"_opt >>= dir};
+    cli.name_matching(ic::name_matching::folded);
+    cli.name_matching(ic::name_matching::exact);
+
+    auto args = std::array{"text", "--outputdir=out"};
+    CHECK_THROWS_AS(cli(args.size(), const_cast<char**>(args.data())),
+                    ic::no_such_option);
+}
+
+TEST_CASE("folded cli_parser rejects options that fold to the same name",
+          "[cli_parser][name_matching]") {
+    int a = 0;
+    int b = 0;
+    ic::cli_parser cli{
+           "output-dir"_opt / "out" >>= a,
+           "outputdir"_opt >>= b};
+    CHECK_THROWS_AS(cli.name_matching(ic::name_matching::folded),
+                    std::invalid_argument);
+
+    auto args = std::array{"text", "--Output-Dir=1"};// still exact
+    CHECK_THROWS_AS(cli(args.size(), const_cast<char**>(args.data())),
+                    ic::no_such_option);
+
+    ic::cli_parser aliases{"output-dir"_opt / "output_dir" >>= a};// the same option
+    CHECK_NOTHROW(aliases.name_matching(ic::name_matching::folded));
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for the typed operand slots
+ */
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/callback_error.hxx>
+using namespace info::cli::udl;
+
+TEST_CASE("operand slots are filled in order",
+          "[cli_parser][operands]") {
+    int count = 0;
+    std::string name;
+    bool v = false;
+    info::cli::cli_parser cli{
+           'v'_opt >>= v,
+           info::cli::operand("count") >>= count,
+           info::cli::operand("name") >= "The name" >>= name};
+    auto args = std::array{"test", "42", "-v", "asd", "extra"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"test"sv, "extra"sv}));
+    CHECK(v);
+    CHECK(count == 42);
+    CHECK(name == "asd");
+}
+
+TEST_CASE("operands slot takes every remaining operand",
+          "[cli_parser][operands]") {
+    int first = 0;
+    std::vector<double> rest;
+    info::cli::cli_parser cli{
+           info::cli::operand("first") >>= first,
+           info::cli::operands("rest") >>= rest};
+    auto args = std::array{"test", "1", "2.5", "--", "-3", "-4e1"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"test"sv}));
+    CHECK(first == 1);
+    CHECK_THAT(rest, Catch::Equals(std::vector{2.5, -3.0, -40.0}));
+}
+
+TEST_CASE("operands slot is presized",
+          "[cli_parser][operands]") {
+    std::vector<int> is;
+    info::cli::cli_parser cli{
+           info::cli::operands("ints") >>= is};
+    cli.presize(true);
+    auto args = std::array{"test", "1", "2", "3"};
+
+    cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(is, Catch::Equals(std::vector{1, 2, 3}));
+    CHECK(is.capacity() < 8);
+}
+
+TEST_CASE("operand slots left unfilled keep their values",
+          "[cli_parser][operands]") {
+    int a = 1;
+    int b = 2;
+    info::cli::cli_parser cli{
+           info::cli::operand("a") >>= a,
+           info::cli::operand("b") >>= b};
+    auto args = std::array{"test", "3"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"test"sv}));
+    CHECK(a == 3);
+    CHECK(b == 2);
+}
+
+TEST_CASE("operand slots report bad values",
+          "[cli_parser][operands]") {
+    int i = 0;
+    info::cli::cli_parser cli{
+           info::cli::operand("i") >>= i};
+    auto args = std::array{"test", "nope"};
+
+    CHECK_THROWS_AS(cli(args.size(), const_cast<char**>(args.data())),
+                    info::cli::callback_error);
+}
+
+TEST_CASE("operand slots cannot be snapshot",
+          "[cli_parser][operands]") {
+    int i = 0;
+    info::cli::cli_parser cli{
+           info::cli::operand("i") >>= i};
+
+    CHECK_THROWS_AS(cli.snapshot(), std::logic_error);
+}
+
+TEST_CASE("operands are streamed into the sink",
+          "[cli_parser][operands]") {
+    bool v = false;
+    info::cli::cli_parser cli{
+           'v'_opt >>= v};
+    auto args = std::array{"test", "a", "-v", "-", "b", "--", "-v", "c"};
+
+    std::vector<std::string> seen;
+    cli(args.size(), const_cast<char**>(args.data()), [&seen](std::string_view op) {
+        seen.emplace_back(op);
+    });
+
+    CHECK(v);
+    CHECK_THAT(seen, Catch::Equals(std::vector<std::string>{"test", "a", "-", "b", "-v", "c"}));
+}
+
+TEST_CASE("operands not taken by slots are streamed into the sink",
+          "[cli_parser][operands]") {
+    int first = 0;
+    info::cli::cli_parser cli{
+           info::cli::operand("first") >>= first};
+    auto args = std::array{"test", "1", "2", "3"};
+
+    std::size_t count = 0;
+    const auto sink = [&count](std::string_view) { ++count; };
+    cli(args.size(), const_cast<char**>(args.data()), sink);
+
+    CHECK(first == 1);
+    CHECK(count == 3);
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for the allocator-aware cli_parser and fixed_cli_parser
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/fixed_cli_parser.hxx>
+using namespace info::cli::udl;
+
+namespace {
+    std::atomic<bool> heap_forbidden{false};
+    std::atomic<std::size_t> forbidden_allocations{0};
+
+    /// Counts the allocations made while heap_forbidden is set
+    struct heap_guard {
+        heap_guard() noexcept {
+            forbidden_allocations = 0;
+            heap_forbidden = true;
+        }
+        ~heap_guard() noexcept {
+            heap_forbidden = false;
+        }
+
+        heap_guard(const heap_guard&) = delete;
+        heap_guard& operator=(const heap_guard&) = delete;
+    };
+
+    /// A memory resource which fails, and remembers, any allocation
+    struct failing_resource final : std::pmr::memory_resource {
+        std::size_t attempts = 0;
+
+    private:
+        void*
+        do_allocate(std::size_t, std::size_t) override {
+            ++attempts;
+            throw std::bad_alloc();
+        }
+
+        void
+        do_deallocate(void*, std::size_t, std::size_t) override { }
+
+        bool
+        do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+}
+
+namespace {
+    /// Allocates, counting the allocation if heap_forbidden is set; the memory is freed with std::free
+    void*
+    counted_allocation(std::size_t size, std::size_t align) noexcept {
+        if (heap_forbidden) {
+            ++forbidden_allocations;
+        }
+        if (size == 0) {
+            size = 1;
+        }
+        if (align <= alignof(std::max_align_t)) {
+            return std::malloc(size);
+        }
+        return std::aligned_alloc(align, (size + align - 1) / align * align);
+    }
+}
+
+// every replaceable form, as the standard memory resources allocate with the aligned ones
+void*
+operator new(std::size_t size) {
+    if (auto ptr = counted_allocation(size, alignof(std::max_align_t))) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void*
+operator new(std::size_t size, std::align_val_t align) {
+    if (auto ptr = counted_allocation(size, static_cast<std::size_t>(align))) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocation(size, alignof(std::max_align_t));
+}
+
+void*
+operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return counted_allocation(size, static_cast<std::size_t>(align));
+}
+
+void
+operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+TEST_CASE("cli_parser allocates from the given memory resource",
+          "[cli_parser][pmr]") {
+    failing_resource upstream;
+    alignas(std::max_align_t) std::array<std::byte, 8192> buffer;
+    std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), &upstream);
+
+    int i = 0;
+    std::string str;
+    bool b = false;
+    info::cli::cli_parser cli({'i'_opt / "int" >= "an integer" >>= i,
+                               's'_opt / "str" >= "a string" >>= str,
+                               'b'_opt / "bool" >>= b},
+                              &resource);
+    std::vector args{"test", "-i42", "op", "--str=text", "-b"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()), &resource);
+
+    CHECK(upstream.attempts == 0);
+    CHECK_THAT(rem, Catch::Equals(std::pmr::vector<std::string_view>{"test"sv, "op"sv}));
+    CHECK(i == 42);
+    CHECK(str == "text");
+    CHECK(b);
+}
+
+TEST_CASE("cli_parser reports exhausting its memory resource",
+          "[cli_parser][pmr]") {
+    failing_resource upstream;
+    int i = 0;
+
+    CHECK_THROWS_AS(info::cli::cli_parser({'i'_opt >>= i}, &upstream),
+                    std::bad_alloc);
+    CHECK(upstream.attempts > 0);
+}
+
+TEST_CASE("fixed_cli_parser does not touch the heap while parsing",
+          "[cli_parser][pmr][fixed]") {
+    int i = 0;
+    bool b = false;
+    info::cli::fixed_cli_parser<2, 4> cli{
+           'i'_opt / "int" >= "an integer" >>= i,
+           'b'_opt / "bool" >>= b};
+    std::vector args{"test", "-i42", "op", "-b", "--int", "7", "op2"};
+
+    // move constructed, keeping the parser's resource; assigning would copy into the heap
+    std::optional<std::pmr::vector<std::string_view>> rem;
+    {
+        heap_guard _;
+        rem.emplace(cli(args.size(), const_cast<char**>(args.data())));
+    }
+
+    CHECK(forbidden_allocations == 0);
+    CHECK_THAT(*rem, Catch::Equals(std::pmr::vector<std::string_view>{"test"sv, "op"sv, "op2"sv}));
+    CHECK(i == 7);
+    CHECK(b);
+}
+
+TEST_CASE("fixed_cli_parser can be reused",
+          "[cli_parser][pmr][fixed]") {
+    int i = 0;
+    info::cli::fixed_cli_parser<1, 2> cli{
+           'i'_opt >>= i};
+    std::vector args{"test", "-i1", "op"};
+
+    for (int n = 0; n < 100; ++n) {
+        auto rem = cli(args.size(), const_cast<char**>(args.data()));
+        CHECK(rem.size() == 2);
+    }
+}
+
+TEST_CASE("presized fixed_cli_parser can be reused",
+          "[cli_parser][pmr][fixed]") {
+    std::vector<int> is;
+    bool b = false;
+    info::cli::fixed_cli_parser<2, 4> cli{
+           'i'_opt >>= is,
+           'b'_opt >>= b};
+    cli.presize(true);
+    std::vector args{"test", "-i1", "-bi2", "op"};
+    cli(args.size(), const_cast<char**>(args.data()));// reserves is
+
+    std::size_t operands = 0;
+    {
+        heap_guard _;
+        for (int n = 0; n < 1000; ++n) {
+            is.clear();
+            operands += cli(args.size(), const_cast<char**>(args.data())).size();
+        }
+    }
+
+    CHECK(forbidden_allocations == 0);
+    CHECK(operands == 2000);
+    CHECK(is == std::vector{1, 2});
+}
+
+TEST_CASE("fixed_cli_parser throws if its limits are exceeded",
+          "[cli_parser][pmr][fixed]") {
+    int i = 0;
+
+    SECTION("too many operands") {
+        info::cli::fixed_cli_parser<1, 2> cli{
+               'i'_opt >>= i};
+        std::vector args{"test", "op", "op2"};
+
+        CHECK_THROWS_AS(cli(args.size(), const_cast<char**>(args.data())),
+                        std::bad_alloc);
+    }
+    SECTION("too many options") {
+        bool b = false;
+        using parser = info::cli::fixed_cli_parser<1, 2>;
+
+        CHECK_THROWS_AS((parser{'i'_opt >>= i, 'b'_opt >>= b}),
+                        std::length_error);
+    }
+    SECTION("too small storage") {
+        using parser = info::cli::fixed_cli_parser<1, 2, 64>;
+
+        CHECK_THROWS_AS((parser{'i'_opt / "int" >= "an integer" >>= i}),
+                        std::bad_alloc);
+    }
+}
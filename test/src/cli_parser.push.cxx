@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for the incremental parsing through the push_parser
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/exc/constraint_error.hxx>
+#include <info/cli/exc/validation_error.hxx>
+#include <info/cli/push_parser.hxx>
+using namespace info::cli::udl;
+
+TEST_CASE("push_parser parses arguments one by one",
+          "[cli_parser][push_parser]") {
+    int i = 0;
+    bool b = false;
+    std::string s;
+    info::cli::cli_parser cli{
+           'i'_opt / "int" >>= i,
+           'b'_opt >>= b,
+           "str"_opt >>= s};
+    std::vector<std::string> ops;
+    info::cli::push_parser push(cli, [&ops](std::string_view op) {
+        ops.emplace_back(op);
+    });
+
+    push.push("-bi4");
+    CHECK(b);
+    CHECK(i == 4);
+
+    push.push("--str");
+    CHECK(push.awaiting_value());
+    {
+        std::string gone = "value";
+        push.push(gone);
+    }
+    CHECK_FALSE(push.awaiting_value());
+    CHECK(s == "value");
+
+    push.push("operand");
+    push.push("-i");
+    push.push("42");
+    push.push("--");
+    push.push("-b");
+    push.finish();
+
+    CHECK(i == 42);
+    CHECK_THAT(ops, Catch::Equals(std::vector<std::string>{"operand", "-b"}));
+}
+
+TEST_CASE("push_parser parses NUL-terminated chunks split anywhere",
+          "[cli_parser][push_parser]") {
+    std::vector<int> is;
+    std::string s;
+    info::cli::cli_parser cli{
+           'i'_opt >>= is,
+           's'_opt >>= s};
+    std::vector<std::string> ops;
+    info::cli::push_parser push(cli, [&ops](std::string_view op) {
+        ops.emplace_back(op);
+    });
+
+    auto input = "-i\0" "12\0" "-i3\0" "op\0" "-s\0" "last"sv;
+    for (std::size_t at = 0; at < input.size(); at += 3) {
+        push.feed(input.substr(at, 3));
+    }
+    push.finish();
+
+    CHECK_THAT(is, Catch::Equals(std::vector{12, 3}));
+    CHECK(s == "last");
+    CHECK_THAT(ops, Catch::Equals(std::vector<std::string>{"op"}));
+}
+
+TEST_CASE("push_parser reports options left without value at the end",
+          "[cli_parser][push_parser]") {
+    int i = 0;
+    info::cli::cli_parser cli{
+           'i'_opt >>= i};
+    info::cli::push_parser push(cli, [](std::string_view) {});
+
+    push.push("-i");
+    CHECK_THROWS_AS(push.finish(), info::cli::bad_option_value);
+
+    push.push("-i");
+    push.push("2");
+    CHECK_NOTHROW(push.finish());
+    CHECK(i == 2);
+}
+
+TEST_CASE("push_parser keeps parsing after an argument throws",
+          "[cli_parser][push_parser]") {
+    int n = 0;
+    info::cli::cli_parser cli{
+           'n'_opt >>= n};
+    std::vector<std::string> ops;
+    info::cli::push_parser push(cli, [&ops](std::string_view op) {
+        ops.emplace_back(op);
+    });
+
+    SECTION("fed again") {
+        CHECK_THROWS(push.feed("-n\0x\0a\0c"sv));
+        push.feed("d\0b\0"sv);
+        push.finish();
+        CHECK_THAT(ops, Catch::Equals(std::vector<std::string>{"a", "cd", "b"}));
+    }
+
+    SECTION("pushed again") {
+        CHECK_THROWS(push.feed("-n\0x\0a\0"sv));
+        push.push("b");
+        push.finish();
+        CHECK_THAT(ops, Catch::Equals(std::vector<std::string>{"a", "b"}));
+    }
+
+    SECTION("finished") {
+        CHECK_THROWS(push.feed("-n\0x\0-n3\0a"sv));
+        push.finish();
+        CHECK(n == 3);
+        CHECK_THAT(ops, Catch::Equals(std::vector<std::string>{"a"}));
+    }
+
+    SECTION("throwing on the last argument") {
+        push.feed("-n\0x"sv);
+        CHECK_THROWS(push.feed("\0"sv));
+        push.feed("b\0"sv);
+        push.finish();
+        CHECK_THAT(ops, Catch::Equals(std::vector<std::string>{"b"}));
+    }
+}
+
+TEST_CASE("push_parser completes fed arguments with pushed ones",
+          "[cli_parser][push_parser]") {
+    std::vector<std::string> ops;
+    info::cli::cli_parser cli{};
+    info::cli::push_parser push(cli, [&ops](std::string_view op) {
+        ops.emplace_back(op);
+    });
+
+    push.feed("a\0b"sv);
+    push.push("c");
+    push.finish();
+
+    CHECK_THAT(ops, Catch::Equals(std::vector<std::string>{"a", "bc"}));
+}
+
+TEST_CASE("push_parser validates the values while they are alive",
+          "[cli_parser][push_parser]") {
+    int i = 0;
+    info::cli::cli_parser cli{
+           'i'_opt >>= i | info::cli::validate([](std::string_view str) { return str[0] != '-'; })};
+    info::cli::push_parser push(cli, [](std::string_view) {});
+
+    CHECK_NOTHROW(push.push("-i1"));
+    push.push("-i");
+    CHECK_THROWS_AS(push.push("-1"), info::cli::validation_error);
+}
+
+TEST_CASE("push_parser checks the constraints at the end of each input",
+          "[cli_parser][push_parser]") {
+    int i = 0;
+    bool b = false;
+    info::cli::cli_parser cli{
+           'i'_opt >>= i,
+           'b'_opt >>= b};
+    cli.constraints({info::cli::required('i')});
+    info::cli::push_parser push(cli, [](std::string_view) {});
+
+    push.push("-b");
+    CHECK_THROWS_AS(push.finish(), info::cli::constraint_error);
+
+    push.push("-i1");
+    CHECK_NOTHROW(push.finish());
+}
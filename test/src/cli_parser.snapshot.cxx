@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for saving and loading cli_parser snapshots
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+#include <info/cli/option.hxx>
+#include <info/cli/snapshot.hxx>
+using namespace info::cli::udl;
+
+namespace {
+    std::string
+    make_snapshot() {
+        int i;
+        bool b;
+        std::string s;
+        info::cli::cli_parser cli{
+               'i'_opt / "int" >= "an int" >>= i,
+               'b'_opt >= "a bool" >>= b,
+               "str"_opt >>= s};
+        return cli.snapshot();
+    }
+
+    // offsets of the fields of the snapshot header used to corrupt a blob
+    constexpr const std::size_t name_count_at = 24;
+    constexpr const std::size_t slot_count_at = 32;
+    constexpr const std::size_t slots_offset_at = 36;
+    constexpr const std::size_t names_offset_at = 40;
+
+    std::uint32_t
+    read_u32(const std::string& blob, std::size_t at) {
+        std::uint32_t val;
+        std::memcpy(&val, blob.data() + at, sizeof(val));
+        return val;
+    }
+
+    void
+    write_u32(std::string& blob, std::size_t at, std::uint32_t val) {
+        std::memcpy(blob.data() + at, &val, sizeof(val));
+    }
+}
+
+TEST_CASE("cli_parser loaded from a snapshot parses like the original",
+          "[cli_parser][snapshot]") {
+    auto blob = make_snapshot();
+
+    int i = 0;
+    bool b = false;
+    std::string s;
+    info::cli::cli_parser cli(info::cli::from_snapshot,
+                              blob,
+                              {info::cli::make_callback(i),
+                               info::cli::make_callback(b),
+                               info::cli::make_callback(s)});
+
+    auto args = std::array{"text",
+                           "-bi42",
+                           "--str",
+                           "value",
+                           "asd"};
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"text"sv, "asd"sv}));
+    CHECK(i == 42);
+    CHECK(b);
+    CHECK(s == "value");
+    CHECK(cli.size() == 6);// i, int, b, str, help, h
+
+    auto unknown = std::array{"--nope"};
+    CHECK_THROWS_AS(cli(unknown.size(), const_cast<char**>(unknown.data())),
+                    info::cli::no_such_option);
+}
+
+TEST_CASE("cli_parser loaded from a snapshot keeps its help and names",
+          "[cli_parser][snapshot]") {
+    auto blob = make_snapshot();
+
+    int i;
+    bool b;
+    std::string s;
+    info::cli::cli_parser cli(info::cli::from_snapshot,
+                              blob,
+                              {info::cli::make_callback(i),
+                               info::cli::make_callback(b),
+                               info::cli::make_callback(s)});
+
+    CHECK_THAT(cli.complete("--"), Catch::Equals(std::vector{"--help"s, "--int"s, "--str"s}));
+    CHECK_THAT(cli.completion_script(info::cli::shell::fish, "x"),
+               Catch::Contains("complete -c x -l int -r -d 'an int'"));
+    CHECK(cli.snapshot() == blob);
+}
+
+TEST_CASE("cli_parser rejects invalid snapshots",
+          "[cli_parser][snapshot][error]") {
+    auto blob = make_snapshot();
+    int i;
+
+    SECTION("not a snapshot") {
+        CHECK_THROWS_AS(info::cli::cli_parser(info::cli::from_snapshot, "garbage", {}),
+                        std::invalid_argument);
+    }
+
+    SECTION("truncated snapshot") {
+        std::string_view truncated(blob.data(), blob.size() - 1);
+        CHECK_THROWS_AS(info::cli::cli_parser(info::cli::from_snapshot, truncated, {}),
+                        std::invalid_argument);
+    }
+
+    SECTION("wrong amount of callbacks") {
+        CHECK_THROWS_AS(info::cli::cli_parser(info::cli::from_snapshot,
+                                              blob,
+                                              {info::cli::make_callback(i)}),
+                        std::invalid_argument);
+    }
+}
+
+TEST_CASE("cli_parser rejects corrupted snapshots",
+          "[cli_parser][snapshot][error]") {
+    auto blob = make_snapshot();
+    int i;
+    bool b;
+    std::string s;
+
+    auto names = read_u32(blob, names_offset_at);
+    auto slots = read_u32(blob, slots_offset_at);
+    auto slot_count = read_u32(blob, slot_count_at);
+
+    SECTION("name out of the blob") {
+        write_u32(blob, names, 0xFFFFFF00u);
+    }
+
+    SECTION("callback out of range") {
+        write_u32(blob, names + 8, 99);
+    }
+
+    SECTION("type out of range") {
+        blob[names + 12] = static_cast<char>(200);
+    }
+
+    SECTION("hash slot out of range") {
+        for (std::uint32_t slot = 0; slot < slot_count; ++slot) {
+            write_u32(blob, slots + slot * 8 + 4, read_u32(blob, name_count_at) + 1);
+        }
+    }
+
+    SECTION("no empty hash slot") {
+        for (std::uint32_t slot = 0; slot < slot_count; ++slot) {
+            write_u32(blob, slots + slot * 8 + 4, 1);
+        }
+    }
+
+    CHECK_THROWS_AS(info::cli::cli_parser(info::cli::from_snapshot,
+                                          blob,
+                                          {info::cli::make_callback(i),
+                                           info::cli::make_callback(b),
+                                           info::cli::make_callback(s)}),
+                    std::invalid_argument);
+}
+
+TEST_CASE("mapped_snapshot maps snapshot files",
+          "[snapshot][mapped_snapshot]") {
+    auto blob = make_snapshot();
+    auto path = "infocli-test.snapshot";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+    }
+
+    {
+        info::cli::mapped_snapshot mapped(path);
+        CHECK(mapped.view() == blob);
+
+        int i = 0;
+        bool b;
+        std::string s;
+        info::cli::cli_parser cli(info::cli::from_snapshot,
+                                  mapped.view(),
+                                  {info::cli::make_callback(i),
+                                   info::cli::make_callback(b),
+                                   info::cli::make_callback(s)});
+        auto args = std::array{"--int=3"};
+        cli(args.size(), const_cast<char**>(args.data()));
+        CHECK(i == 3);
+    }
+    std::remove(path);
+
+    CHECK_THROWS_AS(info::cli::mapped_snapshot("no/such/infocli.snapshot"), std::system_error);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for the validators run after parsing
+ */
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/validation_error.hxx>
+using namespace info::cli::udl;
+
+namespace {
+    bool
+    even(std::string_view str) {
+        return !str.empty() && (str.back() - '0') % 2 == 0;
+    }
+}
+
+TEST_CASE("validators accept valid values",
+          "[cli_parser][validation]") {
+    int i = 0;
+    std::vector<std::string> strs;
+    info::cli::cli_parser cli{
+           'i'_opt / "int" >>= i | info::cli::validate(even),
+           's'_opt >>= strs | info::cli::validate([](std::string_view str) { return !str.empty(); })};
+    auto args = std::array{"test", "-i42", "-s", "a", "--int=8", "-sb"};
+
+    auto rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"test"sv}));
+    CHECK(i == 8);
+    CHECK_THAT(strs, Catch::Equals(std::vector{"a"s, "b"s}));
+}
+
+TEST_CASE("validators report every failure at once",
+          "[cli_parser][validation]") {
+    int i = 0;
+    bool b = false;
+    std::vector<int> is;
+    info::cli::cli_parser cli{
+           'i'_opt / "int" >>= i | info::cli::validate(even),
+           'b'_opt >>= b,
+           "ints"_opt >>= is | info::cli::validate([](std::string_view str) -> std::string {
+               return str == "13" ? "unlucky" : "";
+           })};
+    auto args = std::array{"test", "-i1", "--ints", "13", "-bi3", "--ints=12"};
+
+    try {
+        cli(args.size(), const_cast<char**>(args.data()));
+        FAIL("no validation_error thrown");
+    } catch (const info::cli::validation_error& ex) {
+        REQUIRE(ex.failures.size() == 3);
+        CHECK(ex.failures[0].opt_name == "i");
+        CHECK(ex.failures[0].value == "1");
+        CHECK(ex.failures[0].reason == "rejected by validator");
+        CHECK(ex.failures[1].opt_name == "ints");
+        CHECK(ex.failures[1].reason == "unlucky");
+        CHECK(ex.failures[2].value == "3");
+        CHECK_THAT(ex.what(), Catch::Contains("3 value(s)"));
+    }
+    // the callbacks ran during parsing
+    CHECK(i == 3);
+    CHECK(b);
+    CHECK_THAT(is, Catch::Equals(std::vector{13, 12}));
+}
+
+TEST_CASE("validators are chained and exceptions are failures",
+          "[cli_parser][validation]") {
+    int i = 0;
+    info::cli::cli_parser cli{
+           'i'_opt >>= i
+                       | info::cli::validate(even)
+                       | info::cli::validate([](std::string_view str) -> bool {
+                             if (str.size() > 1) {
+                                 throw std::out_of_range("too long");
+                             }
+                             return true;
+                         })};
+
+    SECTION("first validator fails") {
+        auto args = std::array{"test", "-i", "1"};
+        CHECK_THROWS_MATCHES(cli(args.size(), const_cast<char**>(args.data())),
+                             info::cli::validation_error,
+                             Catch::Predicate<info::cli::validation_error>([](const auto& ex) {
+                                 return ex.failures.at(0).reason == "rejected by validator";
+                             }));
+    }
+    SECTION("second validator throws") {
+        auto args = std::array{"test", "-i", "10"};
+        CHECK_THROWS_MATCHES(cli(args.size(), const_cast<char**>(args.data())),
+                             info::cli::validation_error,
+                             Catch::Predicate<info::cli::validation_error>([](const auto& ex) {
+                                 return ex.failures.at(0).reason == "too long";
+                             }));
+    }
+    SECTION("both pass") {
+        auto args = std::array{"test", "-i", "4"};
+        CHECK_NOTHROW(cli(args.size(), const_cast<char**>(args.data())));
+    }
+}
+
+TEST_CASE("validators run on multiple threads",
+          "[cli_parser][validation]") {
+    std::mutex mtx;
+    std::set<std::thread::id> ids;
+    std::vector<std::string> strs;
+    info::cli::cli_parser cli{
+           's'_opt >>= strs | info::cli::validate([&](std::string_view) {
+               std::this_thread::sleep_for(1ms);
+               std::lock_guard lck(mtx);
+               ids.insert(std::this_thread::get_id());
+               return true;
+           })};
+    cli.validation_threads(4);
+    std::vector<const char*> args{"test"};
+    for (int n = 0; n < 64; ++n) {
+        args.push_back("-sx");
+    }
+
+    cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK(strs.size() == 64);
+    CHECK(ids.size() > 1);
+    CHECK(ids.size() <= 4);
+}
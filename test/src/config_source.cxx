@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for applying configuration files with config_source
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/config_source.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+using namespace info::cli::udl;
+namespace ic = info::cli;
+
+namespace {
+    struct fixture {
+        // every test has its own file, so they can run in parallel
+        std::string path = (std::filesystem::temp_directory_path()
+                            / ("infocli-test-"
+                               + std::to_string(std::hash<std::string>{}(
+                                      Catch::getResultCapture().getCurrentTestName()))
+                               + ".conf"))
+                                  .string();
+        int threads = 0;
+        bool verbose = false;
+        std::string name;
+        std::vector<std::string> calls;
+        ic::cli_parser cli{
+               't'_opt / "threads" >>= [this](int x) {
+                   threads = x;
+                   calls.emplace_back("threads");
+               },
+               'v'_opt / "verbose" >>= [this](bool x) {
+                   verbose = x;
+                   calls.emplace_back("verbose");
+               },
+               "name"_opt >>= [this](std::string_view x) {
+                   name = x;
+                   calls.emplace_back("name");
+               }};
+
+        void
+        write_config(std::string_view contents) const {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << contents;
+        }
+
+        ~fixture() {
+            std::remove(path.c_str());
+        }
+    };
+}
+
+TEST_CASE_METHOD(fixture,
+                 "config_source applies every option of the file",
+                 "[config_source]") {
+    write_config("# the daemon\n"
+                 "threads = 4\n"
+                 "\n"
+                 "  verbose\n"
+                 "name=a = b  \r\n");
+    ic::config_source config(cli, path);
+
+    CHECK(threads == 4);
+    CHECK(verbose);
+    CHECK(name == "a = b");
+    CHECK(calls.size() == 3);
+}
+
+TEST_CASE_METHOD(fixture,
+                 "config_source only reapplies the changed options",
+                 "[config_source]") {
+    write_config("threads = 4\nverbose\nname = x\n");
+    ic::config_source config(cli, path);
+    calls.clear();
+
+    CHECK(config.reload() == 0);
+    CHECK(calls.empty());
+
+    write_config("threads = 8\nverbose\nname = x\n");
+    CHECK(config.reload() == 1);
+    CHECK(calls == std::vector{"threads"s});
+    CHECK(threads == 8);
+
+    write_config("threads = 8\nverbose = false\n");// name is forgotten
+    calls.clear();
+    CHECK(config.reload() == 1);
+    CHECK(calls == std::vector{"verbose"s});
+    CHECK_FALSE(verbose);
+    CHECK(name == "x");
+
+    write_config("threads = 8\nverbose = false\nname = x\n");
+    calls.clear();
+    CHECK(config.reload() == 1);
+    CHECK(calls == std::vector{"name"s});
+}
+
+TEST_CASE_METHOD(fixture,
+                 "config_source notices the file being changed",
+                 "[config_source]") {
+    write_config("threads = 4\n");
+    ic::config_source config(cli, path);
+    CHECK(config.poll() == 0);
+
+    write_config("threads = 5\n");
+    CHECK(config.poll() == 1);
+    CHECK(threads == 5);
+    CHECK(config.poll() == 0);
+}
+
+TEST_CASE_METHOD(fixture,
+                 "config_source reports bad options",
+                 "[config_source]") {
+    SECTION("unknown options") {
+        write_config("processes = 4\n");
+        CHECK_THROWS_AS(ic::config_source(cli, path), ic::no_such_option);
+    }
+
+    SECTION("missing values") {
+        write_config("threads\n");
+        CHECK_THROWS_AS(ic::config_source(cli, path), ic::bad_option_value);
+    }
+
+    SECTION("missing files") {
+        CHECK_THROWS_AS(ic::config_source(cli, "no/such/infocli.conf"), std::system_error);
+    }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020 bodand
+ * Licensed under the BSD 3-Clause license
+ *
+ * Tests for the parsers generated by infocli-gen, from schema/test_options.infocli
+ */
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std::literals;
+
+#include <catch2/catch.hpp>
+
+#include <info/cli/cli_parser.hxx>
+#include <info/cli/exc/bad_option_value.hxx>
+#include <info/cli/exc/callback_error.hxx>
+#include <info/cli/exc/no_such_option.hxx>
+using namespace info::cli::udl;
+
+#include <test_options.hxx>
+
+TEST_CASE("generated parser finds every name of the schema",
+          "[generated_parser]") {
+    using opts = gen_test::test_options;
+    CHECK(opts::find("f") == opts::find("flag"));
+    CHECK(opts::find("n") == opts::find("number"));
+    CHECK(opts::find("i") == opts::find("int"));
+    CHECK(opts::find("f") != opts::find("n"));
+    CHECK(opts::find("c") >= 0);
+    CHECK(opts::find("v") >= 0);
+    CHECK(opts::find("help") == opts::help_id);
+    CHECK(opts::find("h") == opts::help_id);
+
+    CHECK(opts::find("") == -1);
+    CHECK(opts::find("x") == -1);
+    CHECK(opts::find("flags") == -1);
+    CHECK(opts::find("numbe") == -1);
+}
+
+TEST_CASE("generated parser keeps the initializers of the schema",
+          "[generated_parser]") {
+    gen_test::test_options opts;
+    auto args = std::array{"test"};
+
+    auto rem = opts.parse(args.size(), const_cast<char**>(args.data()));
+
+    CHECK_THAT(rem, Catch::Equals(std::vector{"test"sv}));
+    CHECK_FALSE(opts.flag);
+    CHECK(opts.number == 42);
+    CHECK(opts.name.empty());
+    CHECK(opts.ints.empty());
+    CHECK(opts.verbose == 0);
+}
+
+TEST_CASE("generated parser parses like cli_parser",
+          "[generated_parser]") {
+    auto args = GENERATE(std::vector{"test", "-fn", "3", "op"},
+                         std::vector{"test", "--flag", "--number=-4", "-s", "str", "op", "--", "-f"},
+                         std::vector{"test", "-i1", "--int", "2", "-i", "3", "-vvv"},
+                         std::vector{"test", "-cx", "-vfn12", "--name=a=b"},
+                         std::vector{"test", "-n", "1", "-n2", "-", "-fi7"});
+
+    gen_test::test_options gen;
+    auto gen_rem = gen.parse(args.size(), const_cast<char**>(args.data()));
+
+    bool flag = false;
+    int number = 42;
+    std::string name;
+    std::vector<int> ints;
+    char letter = '\0';
+    int verbose = 0;
+    info::cli::cli_parser cli{
+           'f'_opt / "flag" >= "A boolean flag" >>= flag,
+           'n'_opt / "number" >= "A number" >>= number,
+           's'_opt / "name" >= "A string" >>= name,
+           'i'_opt / "int" >>= ints,
+           'c'_opt >>= letter,
+           'v'_opt >>= info::cli::repeat{verbose}};
+    auto cli_rem = cli(args.size(), const_cast<char**>(args.data()));
+
+    CHECK(gen_rem == cli_rem);
+    CHECK(gen.flag == flag);
+    CHECK(gen.number == number);
+    CHECK(gen.name == name);
+    CHECK(gen.ints == ints);
+    CHECK(gen.letter == letter);
+    CHECK(gen.verbose == verbose);
+}
+
+TEST_CASE("generated parser reports errors like cli_parser",
+          "[generated_parser]") {
+    gen_test::test_options opts;
+
+    SECTION("unknown options") {
+        auto args = std::array{"test", "--nope=1"};
+        CHECK_THROWS_AS(opts.parse(args.size(), const_cast<char**>(args.data())),
+                        info::cli::no_such_option);
+    }
+
+    SECTION("unknown short options") {
+        auto args = std::array{"test", "-xf"};
+        CHECK_THROWS_AS(opts.parse(args.size(), const_cast<char**>(args.data())),
+                        info::cli::no_such_option);
+    }
+
+    SECTION("missing values") {
+        auto args = std::array{"test", "--number"};
+        CHECK_THROWS_AS(opts.parse(args.size(), const_cast<char**>(args.data())),
+                        info::cli::bad_option_value);
+    }
+
+    SECTION("bad values") {
+        auto args = std::array{"test", "--number", "many"};
+        CHECK_THROWS_AS(opts.parse(args.size(), const_cast<char**>(args.data())),
+                        info::cli::callback_error);
+    }
+}
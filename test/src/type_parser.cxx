@@ -172,3 +172,43 @@ TEST_CASE("type_parser test cases for custom types", "[type_parser][api][user-de
         }
     }
 }
+
+TEST_CASE("type_parser test cases for key-value pairs", "[type_parser][api][pair]") {
+    const char* last;
+
+    SECTION("type_parser parses the key and the value by their own parsers") {
+        type_parser<std::pair<std::string_view, int>> parser;
+        const char str[] = "answer=42";
+        auto ret = parser(str, last);
+
+        REQUIRE(ret);
+        CHECK(ret->first == "answer");
+        CHECK(ret->first.data() == str);
+        CHECK(ret->second == 42);
+        CHECK(last == str + std::strlen(str));
+    }
+
+    SECTION("type_parser splits on the first =") {
+        type_parser<std::pair<std::string, std::string>> parser;
+        auto ret = parser("a=b=c", last);
+
+        REQUIRE(ret);
+        CHECK(ret->first == "a");
+        CHECK(ret->second == "b=c");
+    }
+
+    SECTION("type_parser fails without =") {
+        type_parser<std::pair<std::string, int>> parser;
+        CHECK_FALSE(parser("answer", last));
+    }
+
+    SECTION("type_parser fails if the key is not consumed whole") {
+        type_parser<std::pair<int, int>> parser;
+        CHECK_FALSE(parser("4x=2", last));
+    }
+
+    SECTION("type_parser fails if the value fails") {
+        type_parser<std::pair<std::string, int>> parser;
+        CHECK_FALSE(parser("answer=x", last));
+    }
+}